@@ -0,0 +1,306 @@
+#ifndef XL_CHANNEL_HPP
+# define XL_CHANNEL_HPP
+# pragma once
+
+#include <coroutine>
+#include <exception> // std::terminate
+#include <limits>
+#include <optional>
+
+#include "list.hpp"
+
+namespace xl
+{
+
+namespace detail
+{
+
+struct job
+{ // intrusive link, a job is either waiting on a channel or queued to run
+  job* n_{};
+  std::coroutine_handle<> h_;
+};
+
+template <class W>
+struct fifo
+{
+  W* f_{}, *l_{};
+
+  bool empty() const noexcept { return !f_; }
+  W* front() const noexcept { return f_; }
+
+  W* pop() noexcept
+  {
+    auto const w(f_);
+    if (!(f_ = static_cast<W*>(w->n_))) l_ = {};
+
+    return w;
+  }
+
+  void push(W* const w) noexcept
+  {
+    w->n_ = {};
+    if (l_) l_->n_ = w; else f_ = w;
+    l_ = w;
+  }
+};
+
+}
+
+class task
+{ // a detached coroutine, started by executor::spawn()
+public:
+  struct promise_type: detail::job
+  {
+    task get_return_object() noexcept
+    {
+      return task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void return_void() const noexcept { }
+    [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+private:
+  friend class executor;
+  std::coroutine_handle<promise_type> h_;
+
+  explicit task(decltype(h_) const h) noexcept: h_(h) { }
+
+public:
+  task(task&& o) noexcept: h_(std::exchange(o.h_, {})) { }
+  ~task() { if (h_) h_.destroy(); }
+
+  task& operator=(task&&) = delete;
+};
+
+class executor
+{ // single threaded, resumes jobs in the order they were posted
+  detail::fifo<detail::job> q_;
+
+public:
+  executor() = default;
+
+  executor(executor const&) = delete;
+  executor& operator=(executor const&) = delete;
+
+  //
+  void post(detail::job& j) noexcept { q_.push(&j); }
+
+  void run()
+  {
+    while (!q_.empty()) q_.pop()->h_.resume();
+  }
+
+  void spawn(task t) noexcept
+  {
+    auto const h(std::exchange(t.h_, {}));
+    h.promise().h_ = h;
+
+    post(h.promise());
+  }
+};
+
+template <typename T>
+class channel
+{ // buffered in an xl::list, capacity 0 is a rendezvous channel
+public:
+  using size_type = typename list<T>::size_type;
+  using value_type = T;
+
+private:
+  struct sender: detail::job
+  {
+    T v_;
+    bool ok_{};
+  };
+
+  struct receiver: detail::job
+  {
+    std::optional<T> v_;
+    list<T> l_;
+    bool all_{};
+  };
+
+  executor& ex_;
+  list<T> b_;
+  size_type n_{};
+  size_type const c_;
+  detail::fifo<sender> ss_;
+  detail::fifo<receiver> rs_;
+  bool closed_{};
+
+  void admit()
+  { // move waiting senders into the freed buffer space
+    for (; !ss_.empty() && (n_ < c_); ++n_)
+    {
+      auto const s(ss_.pop());
+
+      b_.push_back(std::move(s->v_));
+      s->ok_ = true;
+      ex_.post(*s);
+    }
+  }
+
+  void deliver(T&& v)
+  { // straight to the first waiting receiver
+    auto const r(rs_.front());
+
+    if (r->all_) r->l_.push_back(std::move(v)); else r->v_.emplace(std::move(v));
+    ex_.post(*rs_.pop());
+  }
+
+public:
+  explicit channel(executor& ex,
+    size_type const c = std::numeric_limits<size_type>::max()) noexcept:
+    ex_(ex),
+    c_(c)
+  {
+  }
+
+  channel(channel const&) = delete;
+  channel& operator=(channel const&) = delete;
+
+  //
+  void close() noexcept
+  { // wakes everyone, buffered values can still be received
+    closed_ = true;
+
+    while (!rs_.empty()) ex_.post(*rs_.pop());
+    while (!ss_.empty()) ex_.post(*ss_.pop());
+  }
+
+  [[nodiscard]] bool closed() const noexcept { return closed_; }
+  [[nodiscard]] size_type size() const noexcept { return n_; }
+
+  //
+  [[nodiscard]] auto receive() noexcept
+  { // co_await yields std::nullopt once closed and drained
+    struct awaiter: receiver
+    {
+      channel& c_;
+
+      explicit awaiter(channel& c) noexcept: c_(c) { }
+
+      bool await_ready()
+      {
+        if (c_.n_)
+        {
+          this->v_.emplace(std::move(c_.b_.front()));
+          c_.b_.pop_front(); --c_.n_;
+          c_.admit();
+        }
+        else if (!c_.ss_.empty())
+        { // rendezvous
+          auto const s(c_.ss_.pop());
+
+          this->v_.emplace(std::move(s->v_));
+          s->ok_ = true;
+          c_.ex_.post(*s);
+        }
+        else return c_.closed_;
+
+        return true;
+      }
+
+      void await_suspend(std::coroutine_handle<> const h) noexcept
+      {
+        this->h_ = h;
+        c_.rs_.push(this);
+      }
+
+      std::optional<T> await_resume() noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+      {
+        return std::move(this->v_);
+      }
+    };
+
+    return awaiter(*this);
+  }
+
+  [[nodiscard]] auto receive_all() noexcept
+  { // the whole buffer with one swap, empty once closed and drained
+    struct awaiter: receiver
+    {
+      channel& c_;
+
+      explicit awaiter(channel& c) noexcept: c_(c) { this->all_ = true; }
+
+      bool await_ready()
+      {
+        if (c_.n_ || !c_.ss_.empty())
+        {
+          this->l_.swap(c_.b_);
+          c_.n_ = {};
+
+          while (!c_.ss_.empty())
+          {
+            auto const s(c_.ss_.pop());
+
+            this->l_.push_back(std::move(s->v_));
+            s->ok_ = true;
+            c_.ex_.post(*s);
+          }
+
+          return true;
+        }
+
+        return c_.closed_;
+      }
+
+      void await_suspend(std::coroutine_handle<> const h) noexcept
+      {
+        this->h_ = h;
+        c_.rs_.push(this);
+      }
+
+      list<T> await_resume() noexcept { return std::move(this->l_); }
+    };
+
+    return awaiter(*this);
+  }
+
+  [[nodiscard]] auto send(T v) noexcept(
+    std::is_nothrow_move_constructible_v<T>)
+  { // co_await yields false if the channel was closed
+    struct awaiter: sender
+    {
+      channel& c_;
+
+      awaiter(channel& c, T&& v) noexcept(
+        std::is_nothrow_move_constructible_v<T>):
+        sender{{}, std::move(v)},
+        c_(c)
+      {
+      }
+
+      bool await_ready()
+      {
+        if (c_.closed_) return true;
+        else if (!c_.rs_.empty()) c_.deliver(std::move(this->v_));
+        else if (c_.n_ < c_.c_) c_.b_.push_back(std::move(this->v_)), ++c_.n_;
+        else return false;
+
+        return this->ok_ = true;
+      }
+
+      void await_suspend(std::coroutine_handle<> const h) noexcept
+      {
+        this->h_ = h;
+        c_.ss_.push(this);
+      }
+
+      bool await_resume() const noexcept { return this->ok_; }
+    };
+
+    return awaiter(*this, std::move(v));
+  }
+};
+
+}
+
+#endif // XL_CHANNEL_HPP
@@ -23,10 +23,32 @@
 //  TC-19  Resource Management and Destructor Balance
 //  TC-20  Large-List Stress Tests
 //  TC-21  Comprehensive Composition Smoke Test
+//  TC-22  sort_appended
+//  TC-23  sort with a three-way comparator
+//  TC-24  k-way merge (merge(first, last), merge_n)
+//  TC-25  insert_sorted and insert_sorted_range
+//  TC-26  partition and stable_partition
+//  TC-27  extract_if
+//  TC-28  node handles (extract, insert(node_type&&))
+//  TC-29  split, split_n and concat
+//  TC-30  rotate and swap_ranges
+//  TC-31  batched erase, remove_if, unique, pop_front_n and pop_back_n
+//  TC-32  set operations on sorted lists
+//  TC-33  dedup
+//  TC-34  shuffle and sample
+//  TC-35  interleaved traversal (for_each_interleaved, count_if, accumulate, find_if)
+//  TC-36  parallel read-only algorithms (xl::par)
+//  TC-37  parallel mutating algorithms (xl::par)
+//  TC-38  parallel bulk construction (xl::par)
+//  TC-39  mpsc_queue, batched publish and drain
+//  TC-40  coroutine channel and executor
+//  TC-41  compact() and fragmentation()
+//  TC-42  inserts placed near their neighbors
 
 #include <array>
 #include <cassert>
 #include <cctype>
+#include <cstdlib>
 #include <functional>
 #include <initializer_list>
 #include <iostream>
@@ -41,6 +63,33 @@
 #include <vector>
 
 #include "list.hpp"
+#include "channel.hpp"
+#include "mpscqueue.hpp"
+#include "parallelalgorithms.hpp"
+
+struct cached_int { int v; auto operator<=>(cached_int const&) const = default; };
+template <> inline constexpr bool xl::cache_nodes<cached_int>{true};
+
+struct cached_string { std::string v; };
+template <> inline constexpr bool xl::cache_nodes<cached_string>{true};
+
+struct fragile
+{ // copies throw once the budget is used up, moves may throw
+  static inline int budget{-1};
+  int v;
+
+  fragile(int const i) noexcept: v(i) { }
+  fragile(fragile const& o): v(o.v) { if (!budget--) throw 0; }
+  fragile(fragile&& o) noexcept(false): v(o.v) { o.v = -1; }
+};
+
+struct cached_fragile: fragile { using fragile::fragile; };
+template <> inline constexpr bool xl::cache_nodes<cached_fragile>{true};
+
+// every N is a node size of its own, so no other test shares its blocks
+template <std::size_t N> struct cached_padded { int v; char pad[N]{}; };
+template <std::size_t N>
+inline constexpr bool xl::cache_nodes<cached_padded<N>>{true};
 
 void test()
 {
@@ -2569,6 +2618,1390 @@ void test()
       assert(c2.front() == 9 && c2.back() == 1);
     }
   }
+
+  // ─── TC-22  sort_appended ────────────────────────────────────────────────────
+  {
+    // sorted prefix + unsorted tail matches a full sort
+    {
+      std::mt19937 rng(22);
+      xl::list<int> l, ref;
+      for (int i = 0; i < 1000; ++i) l.push_back(int(rng() % 500));
+      l.sort();
+
+      auto const n(l.size());
+      for (int i = 0; i < 300; ++i) l.push_back(int(rng() % 700));
+      ref = l; ref.sort();
+
+      l.sort_appended(std::next(l.cbegin(), n));
+      assert(l == ref && l.size() == 1300);
+    }
+
+    // every sort engine can be used, comparators are honored
+    {
+      xl::list l{1, 5, 9, 8, 2, 7};
+      l.sort_appended<4>(std::next(l.cbegin(), 3));
+      assert((l == xl::list{1, 2, 5, 7, 8, 9}));
+
+      xl::list r{9, 5, 1, 2, 8, 7};
+      r.sort_appended<1>(std::next(r.cbegin(), 3), std::greater<>());
+      assert((r == xl::list{9, 8, 7, 5, 2, 1}));
+    }
+
+    // stable: prefix elements precede tail elements with equal keys
+    {
+      xl::list<std::pair<int, int>> l{{0, 0}, {1, 1}, {2, 2}};
+      l.push_back(std::pair{1, 3}, std::pair{0, 4}, std::pair{2, 5});
+
+      l.sort_appended(std::next(l.cbegin(), 3),
+        [](auto const& a, auto const& b) noexcept { return a.first < b.first; });
+
+      assert((l == xl::list<std::pair<int, int>>{
+        {0, 0}, {0, 4}, {1, 1}, {1, 3}, {2, 2}, {2, 5}}));
+    }
+
+    // degenerate positions: begin (full sort), end (no-op), empty list
+    {
+      xl::list l{3, 1, 2};
+      l.sort_appended(l.cbegin());
+      assert((l == xl::list{1, 2, 3}));
+      l.push_back(0);
+      l.sort_appended(l.cend());
+      assert((l == xl::list{1, 2, 3, 0}));
+
+      xl::list<int> e;
+      e.sort_appended(e.cend());
+      assert(e.empty());
+    }
+  }
+
+  // ─── TC-23  sort with a three-way comparator ─────────────────────────────────
+  {
+    // agrees with the two-way sort on assorted inputs
+    {
+      std::mt19937 rng(23);
+      auto const check([](xl::list<int> l)
+        {
+          auto r(l);
+          l.sort(std::compare_three_way());
+          r.sort();
+          assert(l == r);
+        });
+
+      xl::list<int> rnd, dup, plateau, small, rev;
+
+      for (int i = 0; i < 5000; ++i)
+      {
+        rnd.push_back(int(rng()));
+        dup.push_back(i % 100 ? 42 : int(rng() % 1000));
+        plateau.push_back(i < 2500 ? 42 : i);
+        small.push_back(int(rng() % 10));
+        rev.push_front(i);
+      }
+
+      check(rnd); check(dup); check(plateau); check(small); check(rev);
+      check({}); check({1}); check({2, 1}); check({1, 1, 1});
+    }
+
+    // stable on equal keys
+    {
+      xl::list<std::pair<int, int>> l;
+      for (int i = 0; i < 1000; ++i) l.push_back(std::pair{(i * 7) % 5, i});
+
+      l.sort([](auto const& a, auto const& b) noexcept
+        { return a.first <=> b.first; });
+
+      assert(std::ranges::is_sorted(l) && l.size() == 1000);
+    }
+
+    // natural runs: sorted and plateau inputs take a single pass
+    {
+      std::size_t n{};
+      auto const cmp([&n](int const a, int const b) noexcept
+        { return ++n, a <=> b; });
+
+      xl::list<int> l;
+      for (int i = 0; i < 10000; ++i) l.push_back(i < 5000 ? 42 : i);
+      l.sort(cmp);
+      assert(n < 10000 && std::ranges::is_sorted(l));
+
+      n = {}; l.reverse(); l.unique();
+      l.sort(cmp); // strictly descending, reversed in place
+      assert(n < 10000 && std::ranges::is_sorted(l) && l.size() == 5001);
+    }
+
+    // sub-range and other engines
+    {
+      xl::list l{9, 4, 3, 2, 1, 0};
+      l.sort(std::next(l.cbegin()), l.cend(), std::compare_three_way());
+      assert((l == xl::list{9, 0, 1, 2, 3, 4}));
+
+      for (auto const& f: {+[](xl::list<int>& l) { l.sort<1>(std::compare_three_way()); },
+        +[](xl::list<int>& l) { l.sort<2>(std::compare_three_way()); },
+        +[](xl::list<int>& l) { l.sort<3>(std::compare_three_way()); },
+        +[](xl::list<int>& l) { l.sort<4>(std::compare_three_way()); }})
+      {
+        xl::list m{5, 3, 1, 4, 2};
+        f(m);
+        assert((m == xl::list{1, 2, 3, 4, 5}));
+      }
+    }
+  }
+
+  // ─── TC-24  k-way merge ──────────────────────────────────────────────────────
+  {
+    // 64 sorted shards merge into one sorted list, all shards are emptied
+    {
+      std::mt19937 rng(24);
+      std::vector<xl::list<int>> shards(64);
+      xl::list<int> ref;
+
+      for (auto& s: shards)
+      {
+        for (auto n(rng() % 100); n; --n) s.push_back(int(rng() % 1000));
+        s.sort();
+      }
+
+      shards[7].clear(); // an empty shard
+      ref.assign_range(shards | std::views::join);
+      ref.sort();
+
+      auto const m(xl::merge_n(shards.begin(), shards.end()));
+      assert(m == ref);
+      assert(std::ranges::all_of(shards, &xl::list<int>::empty));
+    }
+
+    // stable: ties are taken from *this first, then in range order
+    {
+      using P = std::pair<int, int>;
+      auto const cmp([](P const& a, P const& b) noexcept
+        { return a.first < b.first; });
+
+      xl::list<P> l{{0, 0}, {2, 0}};
+      std::array<xl::list<P>, 3> o{
+        xl::list<P>{{0, 1}, {1, 1}, {2, 1}},
+        xl::list<P>{},
+        xl::list<P>{{1, 3}, {2, 3}, {3, 3}}};
+
+      l.merge(o.begin(), o.end(), cmp);
+      assert((l == xl::list<P>{{0, 0}, {0, 1}, {1, 1}, {1, 3}, {2, 0},
+        {2, 1}, {2, 3}, {3, 3}}));
+      assert(o[0].empty() && o[2].empty());
+    }
+
+    // degenerate: no lists, one list, *this in the range, custom order
+    {
+      std::vector<xl::list<int>> v;
+      assert(xl::merge_n(v.begin(), v.end()).empty());
+
+      v.push_back({1, 2, 3});
+      auto const m(xl::merge_n(v.begin(), v.end()));
+      assert((m == xl::list{1, 2, 3}) && v[0].empty());
+
+      xl::list<int> l{3, 1};
+      v.assign({{5, 4}, {2, 0}});
+      l.merge(v.begin(), v.end(), std::greater<>());
+      l.merge(&l, &l + 1, std::greater<>());
+      assert((l == xl::list{5, 4, 3, 2, 1, 0}));
+    }
+  }
+
+  // ─── TC-25  insert_sorted and insert_sorted_range ────────────────────────────
+  {
+    // single inserts at the front, back and middle keep the list sorted
+    {
+      std::mt19937 rng(25);
+      xl::list<int> l;
+
+      for (int i = 0; i < 2000; ++i)
+      {
+        auto const v(int(rng() % 300));
+        assert(*l.insert_sorted(v) == v);
+      }
+
+      assert(std::ranges::is_sorted(l) && l.size() == 2000);
+
+      l.insert_sorted(-1); l.insert_sorted(1000);
+      assert(l.front() == -1 && l.back() == 1000);
+    }
+
+    // equal keys are inserted after the existing ones
+    {
+      using P = std::pair<int, int>;
+      auto const cmp([](P const& a, P const& b) noexcept
+        { return a.first < b.first; });
+
+      xl::list<P> l{{1, 0}, {2, 0}, {2, 1}, {3, 0}};
+      l.insert_sorted({2, 2}, cmp);
+      l.insert_sorted({1, 1}, cmp);
+      l.insert_sorted({3, 1}, cmp);
+      l.insert_sorted({0, 0}, cmp);
+      assert((l == xl::list<P>{{0, 0}, {1, 0}, {1, 1}, {2, 0}, {2, 1},
+        {2, 2}, {3, 0}, {3, 1}}));
+
+      l.insert_sorted_range(std::vector<P>{{2, 4}, {0, 1}, {2, 3}}, cmp);
+      assert((l == xl::list<P>{{0, 0}, {0, 1}, {1, 0}, {1, 1}, {2, 0},
+        {2, 1}, {2, 2}, {2, 4}, {2, 3}, {3, 0}, {3, 1}}));
+    }
+
+    // batch insert agrees with sorting everything
+    {
+      std::mt19937 rng(250);
+      xl::list<int> l;
+      std::vector<int> v;
+
+      for (int i = 0; i < 1000; ++i) l.push_back(int(rng() % 500));
+      for (int i = 0; i < 700; ++i) v.push_back(int(rng() % 800));
+      l.sort();
+
+      xl::list ref(l);
+      ref.append_range(v);
+      ref.sort();
+
+      l.insert_sorted_range(v);
+      assert(l == ref);
+
+      l.insert_sorted_range({3, 2, 1}, std::less<>());
+      xl::list<int> e;
+      e.insert_sorted_range({3, 1, 2});
+      e.insert_sorted_range(std::vector<int>{});
+      assert((e == xl::list{1, 2, 3}) && l.size() == 1703);
+    }
+  }
+
+  // ─── TC-26  partition and stable_partition ───────────────────────────────────
+  {
+    auto const even([](int const i) noexcept { return !(i % 2); });
+
+    // whole list, stable, partition point returned
+    {
+      xl::list l{1, 2, 3, 4, 5, 6, 7, 8, 9};
+      auto const p(l.stable_partition(even));
+      assert((l == xl::list{2, 4, 6, 8, 1, 3, 5, 7, 9}) && *p == 1);
+      assert(std::distance(l.begin(), p) == 4);
+      assert(std::ranges::equal(std::ranges::subrange(p, l.end()),
+        xl::list{1, 3, 5, 7, 9}));
+      assert(std::prev(p) == std::next(l.begin(), 3)); // p is valid
+      assert(l.back() == 9 && l.front() == 2 && l.size() == 9);
+
+      std::list<int> r(l.begin(), l.end());
+      std::ranges::reverse(l); std::ranges::reverse(r);
+      assert(std::ranges::equal(l, r)); // links are consistent both ways
+    }
+
+    // all pass, none pass, empty, single
+    {
+      xl::list l{2, 4, 6};
+      assert(l.partition(even) == l.end() && (l == xl::list{2, 4, 6}));
+      assert(l.back() == 6);
+
+      xl::list m{1, 3, 5};
+      assert(m.partition(even) == m.begin() && (m == xl::list{1, 3, 5}));
+      assert(m.front() == 1);
+
+      xl::list<int> e;
+      assert(e.partition(even) == e.end() && e.empty());
+
+      xl::list s{1};
+      assert(s.stable_partition(even) == s.begin());
+    }
+
+    // sub-range [b, e), the surroundings are untouched
+    {
+      xl::list l{9, 1, 2, 3, 4, 5, 6, 0};
+      auto const p(l.stable_partition(std::next(l.cbegin()),
+        std::prev(l.cend()), even));
+      assert((l == xl::list{9, 2, 4, 6, 1, 3, 5, 0}) && *p == 1);
+      assert(l.front() == 9 && l.back() == 0);
+      assert(*std::prev(l.end(), 2) == 5 && *std::next(l.begin()) == 2);
+
+      xl::list m{1, 2, 3, 4};
+      m.partition(std::next(m.cbegin(), 2), m.cend(), even);
+      assert((m == xl::list{1, 2, 4, 3}) && m.back() == 3);
+    }
+
+    // matches std::stable_partition on random input
+    {
+      std::mt19937 rng(26);
+      std::vector<int> v;
+      for (int i = 0; i < 5000; ++i) v.push_back(int(rng() % 1000));
+
+      xl::list l(v.begin(), v.end());
+      auto const p(l.stable_partition(even));
+      auto const q(std::stable_partition(v.begin(), v.end(), even));
+
+      assert(std::ranges::equal(l, v));
+      assert(std::distance(l.begin(), p) == std::distance(v.begin(), q));
+    }
+
+    // a throwing pred leaves the tested elements partitioned, ahead of the rest
+    {
+      auto const throws_at([&](int const n)
+        {
+          return [=, c = 0](int const i) mutable
+            {
+              if (++c == n) throw std::runtime_error("pred");
+              return even(i);
+            };
+        }
+      );
+
+      xl::list l{1, 2, 3, 4, 5, 6, 7, 8};
+      try { l.stable_partition(throws_at(5)); assert(false); }
+      catch (std::runtime_error const&) { }
+      assert((l == xl::list{2, 4, 1, 3, 5, 6, 7, 8}) && 8 == l.size());
+      assert(l.front() == 2 && l.back() == 8);
+
+      std::list<int> r(l.begin(), l.end());
+      std::ranges::reverse(l); std::ranges::reverse(r);
+      assert(std::ranges::equal(l, r));
+
+      xl::list m{1, 2, 3};
+      try { m.partition(throws_at(1)); assert(false); }
+      catch (std::runtime_error const&) { }
+      assert((m == xl::list{1, 2, 3}) && m.back() == 3);
+
+      xl::list s{9, 1, 2, 3, 4, 0};
+      try
+      {
+        s.stable_partition(std::next(s.cbegin()), std::prev(s.cend()),
+          throws_at(3));
+        assert(false);
+      }
+      catch (std::runtime_error const&) { }
+      assert((s == xl::list{9, 2, 1, 3, 4, 0}) && s.back() == 0);
+    }
+  }
+
+  // ─── TC-27  extract_if ───────────────────────────────────────────────────────
+  {
+    auto const odd([](int const i) noexcept { return i % 2; });
+
+    // matching nodes move into a new list, both orders are kept
+    {
+      xl::list l{1, 2, 3, 4, 5, 6, 7};
+      auto const a(&l.front());
+
+      auto const r(l.extract_if(odd));
+      assert((l == xl::list{2, 4, 6}) && (r == xl::list{1, 3, 5, 7}));
+      assert(&r.front() == a); // relinked, not copied
+      assert(l.back() == 6 && r.back() == 7);
+    }
+
+    // appends to an existing output list
+    {
+      xl::list l{1, 2, 3, 4};
+      xl::list o{10, 20};
+      l.extract_if(odd, o);
+      assert((l == xl::list{2, 4}) && (o == xl::list{10, 20, 1, 3}));
+
+      l.extract_if([](int) noexcept { return true; }, o);
+      assert(l.empty() && (o == xl::list{10, 20, 1, 3, 2, 4}));
+
+      o.extract_if([](int) noexcept { return false; }, l);
+      assert(l.empty() && o.size() == 6);
+    }
+
+    // no element is destroyed or copied
+    {
+      static int live;
+      struct C
+      {
+        int v;
+        explicit C(int const i) noexcept: v(i) { ++live; }
+        C(C const&) = delete;
+        ~C() { --live; }
+      };
+
+      xl::list<C> l;
+      for (int i = 0; i < 10; ++i) l.emplace_back(i);
+
+      auto const r(l.extract_if([](C const& c) noexcept { return c.v < 5; }));
+      assert(live == 10 && l.size() == 5 && r.size() == 5);
+      assert(l.front().v == 5 && r.back().v == 4);
+    }
+
+    // a throwing pred extracts nothing and loses no element
+    {
+      xl::list l{1, 2, 3, 4, 5, 6, 7, 8};
+      xl::list o{10};
+
+      try
+      {
+        l.extract_if([c = 0](int const i) mutable
+          {
+            if (5 == ++c) throw std::runtime_error("pred");
+            return i % 2;
+          }, o
+        );
+        assert(false);
+      }
+      catch (std::runtime_error const&) { }
+
+      assert((o == xl::list{10}) && 8 == l.size());
+      assert((l == xl::list{2, 4, 1, 3, 5, 6, 7, 8}) && l.back() == 8);
+
+      std::list<int> r(l.begin(), l.end());
+      std::ranges::reverse(l); std::ranges::reverse(r);
+      assert(std::ranges::equal(l, r));
+    }
+  }
+
+  // ─── TC-28  node handles ─────────────────────────────────────────────────────
+  {
+    // a node moves between lists without reallocation
+    {
+      xl::list l{1, 2, 3};
+      xl::list<int> m{10, 20};
+
+      auto const a(&*std::next(l.begin()));
+      auto nh(l.extract(std::next(l.cbegin())));
+      assert(nh && !nh.empty() && &nh.value() == a && nh.value() == 2);
+      assert((l == xl::list{1, 3}) && l.size() == 2);
+
+      auto const i(m.insert(std::next(m.cbegin()), std::move(nh)));
+      assert(nh.empty() && &*i == a && (m == xl::list{10, 2, 20}));
+      assert(std::next(i) == std::prev(m.end()) && *std::prev(i) == 10);
+    }
+
+    // front, back and sole nodes; handles are move-only
+    {
+      static_assert(!std::is_copy_constructible_v<xl::list<int>::node_type>);
+      static_assert(std::is_nothrow_move_constructible_v<xl::list<int>::node_type>);
+
+      xl::list l{1, 2, 3};
+      auto f(l.extract(l.cbegin()));
+      auto b(l.extract(std::prev(l.cend())));
+      assert((l == xl::list{2}) && l.front() == 2 && l.back() == 2);
+
+      l.insert(l.cbegin(), std::move(b));
+      l.insert(l.cend(), std::move(f));
+      assert((l == xl::list{3, 2, 1}) && l.back() == 1 && l.front() == 3);
+
+      auto s(l.extract(l.cbegin())); s.value() = 7;
+      swap(s, f); assert(s.empty() && f.value() == 7);
+      f = l.extract(l.cbegin());
+      f = l.extract(l.cbegin());
+      assert(l.empty() && f.value() == 1);
+
+      xl::list<int>::node_type e;
+      assert(l.insert(l.cend(), std::move(e)) == l.end() && l.empty());
+    }
+
+    // a handle destroys an owned value exactly once
+    {
+      static int live;
+      struct C
+      {
+        C() noexcept { ++live; }
+        ~C() { --live; }
+      };
+
+      {
+        xl::list<C> l(3);
+        auto nh(l.extract(l.cbegin()));
+        assert(live == 3 && l.size() == 2);
+        nh = l.extract(l.cbegin());
+        assert(live == 2 && l.size() == 1);
+      }
+
+      assert(!live);
+    }
+  }
+
+  // ─── TC-29  split, split_n and concat ────────────────────────────────────────
+  {
+    // split at begin, middle and end
+    {
+      xl::list l{1, 2, 3, 4, 5};
+      auto r(l.split(std::next(l.cbegin(), 2)));
+      assert((l == xl::list{1, 2}) && (r == xl::list{3, 4, 5}));
+      assert(l.back() == 2 && r.front() == 3 && r.back() == 5);
+
+      auto e(l.split(l.cend()));
+      assert(e.empty() && (l == xl::list{1, 2}));
+
+      auto a(r.split(r.cbegin()));
+      assert(r.empty() && (a == xl::list{3, 4, 5}));
+    }
+
+    // split_n: k nearly equal parts in order
+    {
+      xl::list l(std::views::iota(0, 10));
+      auto const v(l.split_n(4));
+      assert(l.empty() && v.size() == 4);
+      assert((v[0] == xl::list{0, 1, 2}) && (v[1] == xl::list{3, 4, 5}));
+      assert((v[2] == xl::list{6, 7}) && (v[3] == xl::list{8, 9}));
+
+      xl::list m{1, 2};
+      auto const w(m.split_n(3));
+      assert((w[0] == xl::list{1}) && (w[1] == xl::list{2}) && w[2].empty());
+      assert(m.split_n(0).empty());
+    }
+
+    // concat joins lists in order and empties them
+    {
+      xl::list a{1, 2}, b{3}, c{4, 5};
+      xl::list<int> e;
+      auto const r(xl::concat(a, e, b, std::move(c), xl::list{6}));
+      assert((r == xl::list{1, 2, 3, 4, 5, 6}) && r.back() == 6);
+      assert(a.empty() && b.empty() && c.empty());
+
+      xl::list l(std::views::iota(0, 100));
+      auto v(l.split_n(7));
+      auto const j(xl::concat(v[0], v[1], v[2], v[3], v[4], v[5], v[6]));
+      assert(std::ranges::equal(j, std::views::iota(0, 100)));
+    }
+  }
+
+  // ─── TC-30  rotate and swap_ranges ───────────────────────────────────────────
+  {
+    constexpr int N = 6;
+
+    auto const valid([](xl::list<int> const& l, std::vector<int> const& v)
+      {
+        return std::ranges::equal(l, v) &&
+          std::ranges::equal(l | std::views::reverse, v | std::views::reverse);
+      });
+
+    // rotate agrees with std::rotate on every (first, middle, last)
+    for (int a = 0; a <= N; ++a)
+      for (int m = a; m <= N; ++m)
+        for (int b = m; b <= N; ++b)
+        {
+          std::vector<int> v(N);
+          std::iota(v.begin(), v.end(), 0);
+          xl::list l(v.begin(), v.end());
+
+          auto const r(l.rotate(std::next(l.cbegin(), a),
+            std::next(l.cbegin(), m), std::next(l.cbegin(), b)));
+          auto const q(std::rotate(v.begin() + a, v.begin() + m,
+            v.begin() + b));
+
+          assert(valid(l, v));
+          assert(std::distance(l.begin(), r) == q - v.begin());
+          if (r != l.end()) assert(*r == *q && (r == l.begin() || *std::prev(r) == q[-1]));
+        }
+
+    // swap_ranges on every pair of non-overlapping ranges
+    for (int a = 0; a <= N; ++a)
+      for (int b = a; b <= N; ++b)
+        for (int c = b; c <= N; ++c)
+          for (int d = c; d <= N; ++d)
+          {
+            std::vector<int> v(N);
+            std::iota(v.begin(), v.end(), 0);
+            xl::list l(v.begin(), v.end());
+
+            l.swap_ranges(std::next(l.cbegin(), a), std::next(l.cbegin(), b),
+              std::next(l.cbegin(), c), std::next(l.cbegin(), d));
+
+            std::vector<int> w(v.begin(), v.begin() + a);
+            w.insert(w.end(), v.begin() + c, v.begin() + d);
+            w.insert(w.end(), v.begin() + b, v.begin() + c);
+            w.insert(w.end(), v.begin() + a, v.begin() + b);
+            w.insert(w.end(), v.begin() + d, v.end());
+
+            assert(valid(l, w));
+          }
+
+    // round-robin: rotating the front to the back
+    {
+      xl::list l{1, 2, 3, 4};
+      l.rotate(l.cbegin(), std::next(l.cbegin()), l.cend());
+      assert((l == xl::list{2, 3, 4, 1}) && l.back() == 1);
+    }
+  }
+
+  // ─── TC-31  batched erase, remove_if, unique, pop_front_n and pop_back_n ─────
+  {
+    static int live;
+    struct C
+    {
+      int v;
+      C(int const i) noexcept: v(i) { ++live; }
+      C(C const& o) noexcept: v(o.v) { ++live; }
+      ~C() { --live; }
+      bool operator==(C const&) const = default;
+    };
+
+    // pop_front_n and pop_back_n, including k > size()
+    {
+      xl::list<C> l(std::views::iota(0, 10));
+      l.pop_front_n(3);
+      assert(live == 7 && l.front().v == 3 && l.size() == 7);
+      l.pop_back_n(2);
+      assert(live == 5 && l.back().v == 7 && l.size() == 5);
+      l.pop_front_n(0); l.pop_back_n(0);
+      assert(live == 5 && l.front().v == 3 && l.back().v == 7);
+
+      assert(std::ranges::equal(l | std::views::reverse |
+        std::views::transform(&C::v), std::views::iota(3, 8) | std::views::reverse));
+
+      l.pop_back_n(4);
+      assert(live == 1 && l.front().v == 3 && l.back().v == 3);
+      l.pop_front_n(100);
+      assert(!live && l.empty());
+      l.pop_back_n(1);
+      l.push_back(C(1)); l.pop_back_n(5);
+      assert(!live && l.empty());
+    }
+
+    // erase(range) returns the following position and frees every node
+    {
+      xl::list<C> l(std::views::iota(0, 10));
+      auto const i(l.erase(std::next(l.cbegin(), 2), std::next(l.cbegin(), 8)));
+      assert(live == 4 && i->v == 8 && std::prev(i)->v == 1);
+      assert(l.erase(l.cbegin(), l.cend()) == l.end() && l.empty() && !live);
+    }
+
+    // runs of victims and duplicates at both ends
+    {
+      xl::list<C> l{0, 0, 1, 0, 1, 1, 0, 0};
+      assert(l.remove_if([](C const& c) noexcept { return !c.v; }) == 5);
+      assert(live == 3 && l.size() == 3 && l.front().v == 1 && l.back().v == 1);
+
+      l.push_front(C(0)); l.push_back(C(2)); l.push_back(C(2));
+      assert(l.unique() == 3 && live == 3);
+      assert(std::ranges::equal(l | std::views::transform(&C::v), xl::list{0, 1, 2}));
+      assert(l.back().v == 2 && std::prev(l.end(), 2)->v == 1);
+    }
+
+    // the predicate sees every element exactly once
+    {
+      xl::list<C> l{0, 0, 1, 0, 1, 1, 0, 0, 1};
+      int calls{};
+
+      assert(l.remove_if([&](C const& c) noexcept { return ++calls, !c.v; }) == 5);
+      assert(9 == calls && live == 4);
+
+      l.clear();
+    }
+
+    // remove_if evaluates the predicate once per element, front to back
+    {
+      xl::list l{1, 1, 0, 1, 1, 0};
+      std::vector<int> seen;
+      l.remove_if([&](int const i) { return seen.push_back(i), i; });
+      assert((seen == std::vector{1, 1, 0, 1, 1, 0}) && (l == xl::list{0, 0}));
+    }
+
+    assert(!live);
+  }
+
+  // ─── TC-32  set operations on sorted lists ───────────────────────────────────
+  {
+    auto const valid([](xl::list<int> const& l, std::vector<int> const& v)
+      {
+        return std::ranges::equal(l, v) &&
+          std::ranges::equal(l | std::views::reverse, v | std::views::reverse) &&
+          (l.empty() || (l.front() == v.front() && l.back() == v.back()));
+      });
+
+    // agree with the std:: algorithms, including duplicates and empty inputs
+    std::mt19937 rng(32);
+
+    for (int n = 0; n < 200; ++n)
+    {
+      std::vector<int> a(rng() % 20), b(rng() % 20), r;
+      for (auto& e: a) e = int(rng() % 15);
+      for (auto& e: b) e = int(rng() % 15);
+      std::ranges::sort(a); std::ranges::sort(b);
+
+      xl::list<int> l, o;
+
+      l.assign_range(a); o.assign_range(b); r.clear();
+      l.merge_unique(o);
+      std::ranges::set_union(a, b, std::back_inserter(r));
+      assert(valid(l, r) && o.empty());
+
+      l.assign_range(a); o.assign_range(b); r.clear();
+      l.set_intersection(o);
+      std::ranges::set_intersection(a, b, std::back_inserter(r));
+      assert(valid(l, r) && o.empty());
+
+      l.assign_range(a); o.assign_range(b); r.clear();
+      l.set_difference(o);
+      std::ranges::set_difference(a, b, std::back_inserter(r));
+      assert(valid(l, r) && o.empty());
+
+      l.assign_range(a); o.assign_range(b); r.clear();
+      l.set_symmetric_difference(o);
+      std::ranges::set_symmetric_difference(a, b, std::back_inserter(r));
+      assert(valid(l, r) && o.empty());
+    }
+
+    // surviving nodes are relinked, equal elements are taken from *this
+    {
+      using P = std::pair<int, int>;
+      auto const cmp([](P const& a, P const& b) noexcept
+        { return a.first < b.first; });
+
+      xl::list<P> l{{1, 0}, {3, 0}, {5, 0}};
+      xl::list<P> o{{1, 1}, {2, 1}, {5, 1}, {6, 1}};
+      auto const b(&*std::next(o.begin()));
+
+      l.merge_unique(o, cmp);
+      assert((l == xl::list<P>{{1, 0}, {2, 1}, {3, 0}, {5, 0}, {6, 1}}));
+      assert(&*std::next(l.begin()) == b && o.empty());
+    }
+
+    // self operations
+    {
+      xl::list l{1, 2, 3};
+      l.merge_unique(l); l.set_intersection(l);
+      assert((l == xl::list{1, 2, 3}));
+      l.set_difference(l);
+      assert(l.empty());
+    }
+  }
+
+  // ─── TC-33  dedup ────────────────────────────────────────────────────────────
+  {
+    // first occurrences are kept in their original order
+    {
+      std::mt19937 rng(33);
+      std::vector<int> v(5000);
+      for (auto& e: v) e = int(rng() % 700);
+
+      std::vector<int> r;
+      for (std::vector<bool> seen(700); auto const e: v)
+        if (!seen[e]) seen[e] = true, r.push_back(e);
+
+      xl::list l(v.begin(), v.end());
+      assert(l.dedup() == v.size() - r.size());
+      assert(std::ranges::equal(l, r) && l.back() == r.back());
+      assert(std::ranges::equal(l | std::views::reverse, r | std::views::reverse));
+      assert(!l.dedup());
+    }
+
+    // custom hash and equality, runs of duplicates, edge cases
+    {
+      xl::list l{11, 1, 21, 2, 31, 12, 3, 3, 3};
+      assert(l.dedup([](int const i) noexcept { return std::size_t(i % 10); },
+        [](int const a, int const b) noexcept { return a % 10 == b % 10; }) == 6);
+      assert((l == xl::list{11, 2, 3}) && l.back() == 3);
+
+      xl::list<std::string> s{"a", "b", "a", "a", "c", "b"};
+      assert(s.dedup() == 3 && (s == xl::list<std::string>{"a", "b", "c"}));
+
+      xl::list<int> e;
+      assert(!e.dedup());
+      xl::list o{7, 7, 7};
+      assert(o.dedup() == 2 && (o == xl::list{7}) && o.back() == 7);
+    }
+  }
+
+  // ─── TC-34  shuffle and sample ───────────────────────────────────────────────
+  {
+    std::mt19937 rng(34);
+
+    // shuffle permutes the nodes and keeps the links consistent
+    {
+      xl::list l(std::views::iota(0, 1000));
+      auto const a(&l.front());
+
+      l.shuffle(rng);
+      assert(l.size() == 1000 && !std::ranges::equal(l, std::views::iota(0, 1000)));
+      assert(std::ranges::count(l | std::views::transform(
+        [](int const& i) noexcept { return &i; }), a) == 1); // relinked
+
+      std::vector<int> r(l.rbegin(), l.rend());
+      assert(std::ranges::equal(r | std::views::reverse, l));
+      assert(*l.before_end() == l.back() && r.front() == l.back());
+
+      l.sort();
+      assert(std::ranges::equal(l, std::views::iota(0, 1000)));
+
+      xl::list<int> e; e.shuffle(rng); assert(e.empty());
+      xl::list o{1}; o.shuffle(rng); assert((o == xl::list{1}) && o.back() == 1);
+    }
+
+    // sample extracts k nodes in their original order
+    {
+      xl::list l(std::views::iota(0, 100));
+      auto const s(l.sample(10, rng));
+      assert(s.size() == 10 && l.size() == 90 && std::ranges::is_sorted(s));
+      assert(std::ranges::is_sorted(l) && l.back() == *std::prev(l.end()));
+
+      auto m(s); m.merge(l);
+      assert(std::ranges::equal(m, std::views::iota(0, 100)));
+
+      xl::list t{1, 2, 3};
+      auto a(t.sample(5, rng));
+      assert(t.empty() && (a == xl::list{1, 2, 3}) && a.back() == 3);
+      assert(a.sample(0, rng).empty());
+    }
+
+    // every element is about equally likely to be picked
+    {
+      std::array<int, 10> hits{};
+
+      for (int n = 0; n < 3000; ++n)
+      {
+        xl::list l(std::views::iota(0, 10));
+        for (auto const i: l.sample(3, rng)) ++hits[i];
+      }
+
+      assert(std::ranges::all_of(hits, [](int const h) noexcept
+        { return h > 700 && h < 1100; })); // 900 expected
+    }
+  }
+
+  // ─── TC-35  interleaved traversal ────────────────────────────────────────────
+  {
+    for (int n = 0; n < 40; ++n)
+    {
+      xl::list l(std::views::iota(0, n));
+
+      // checkpoints: none, ends, repeated and many (more than one batch)
+      std::vector<std::vector<xl::list<int>::iterator>> cps(4);
+      cps[1] = {l.begin(), l.end()};
+      cps[2] = {std::next(l.begin(), n / 3), std::next(l.begin(), n / 3)};
+      for (int i = 0; i < n; i += 3) cps[3].push_back(std::next(l.begin(), i));
+
+      for (auto const& cp: cps)
+      {
+        // every element is visited exactly once
+        xl::for_each_interleaved(l, cp, [](int& i) noexcept { i += 1000; });
+        assert(std::ranges::equal(l, std::views::iota(1000, 1000 + n)));
+        xl::for_each_interleaved(l, cp, [](int& i) noexcept { i -= 1000; });
+
+        assert(xl::count_if(l, cp, [](int const i) noexcept { return i % 2; }) ==
+          std::size_t(n / 2));
+        assert(xl::accumulate(l, cp, 0, std::plus<>()) == n * (n - 1) / 2);
+
+        for (int k = 0; k < n; ++k)
+        {
+          auto const i(xl::find_if(l, cp, [k](int const i) noexcept { return i == k; }));
+          assert(i != l.end() && *i == k && std::prev(i, k) == l.begin());
+        }
+
+        assert(xl::find_if(l, cp, [](int) noexcept { return false; }) == l.end());
+      }
+
+      assert(xl::count_if(l, [](int const i) noexcept { return i < 5; }) ==
+        std::size_t(std::min(n, 5)));
+      assert(xl::accumulate(l, 0) == n * (n - 1) / 2);
+      assert(xl::accumulate(std::as_const(l), 1,
+        [](int const a, int const b) noexcept { return a + b; }) == 1 + n * (n - 1) / 2);
+    }
+
+    // const lists and for_each_interleaved returning the functor
+    {
+      xl::list const l{1, 2, 3};
+      std::size_t n{};
+      xl::for_each_interleaved(l, [&n](int const&) noexcept { ++n; });
+      assert(n == 3);
+    }
+  }
+
+  // ─── TC-36  parallel read-only algorithms ────────────────────────────────────
+  {
+    // checkpoints are evenly spaced and start at begin
+    {
+      xl::list l(std::views::iota(0, 1000));
+      auto const cp(xl::par::checkpoints(l, 4));
+      assert(cp.size() == 4 && cp.front() == l.begin());
+
+      for (std::size_t j(1); j != cp.size(); ++j)
+      {
+        auto const d(std::distance(cp[j - 1], cp[j]));
+        assert(d > 200 && d < 300);
+      }
+
+      assert(xl::par::checkpoints(l, 5000).size() == 1000);
+      assert(xl::par::checkpoints(l, 0).size() == 1);
+    }
+
+    for (int n: {0, 1, 2, 7, 100, 10000})
+      for (std::size_t t: {0, 1, 2, 3, 8})
+      {
+        xl::list l(std::views::iota(0, n));
+
+        xl::par::for_each(l, [](int& i) noexcept { i *= 2; }, t);
+        assert(std::ranges::equal(l, std::views::iota(0, n) |
+          std::views::transform([](int const i) noexcept { return 2 * i; })));
+
+        xl::par::transform(l, [](int const i) noexcept { return i / 2; }, t);
+        assert(std::ranges::equal(l, std::views::iota(0, n)));
+
+        assert(xl::par::transform_reduce(l, 0ll, std::plus<>(),
+          [](int const i) noexcept { return (long long)i; }, t) ==
+          (long long)n * (n - 1) / 2);
+
+        assert(xl::par::count_if(l, [](int const i) noexcept { return i % 3; },
+          t) == std::size_t(n - (n + 2) / 3));
+
+        for (int k: {0, n / 2, n - 1})
+          if (k >= 0 && k < n)
+          {
+            auto const i(xl::par::find_if(l,
+              [k](int const i) noexcept { return i >= k; }, t));
+            assert(i != l.end() && *i == k && std::prev(i, k) == l.begin());
+          }
+
+        assert(xl::par::find_if(l, [](int) noexcept { return false; }, t) ==
+          l.end());
+      }
+
+    // cached checkpoints, deterministic non-commutative reduction in order
+    {
+      xl::list<std::string> l{"a", "b", "c", "d", "e", "f", "g"};
+      auto const cp(xl::par::checkpoints(l, 3));
+
+      auto const s(xl::par::transform_reduce(l, cp, std::string(),
+        std::plus<>(), std::identity(), 3));
+      assert(s == "abcdefg");
+
+      assert(xl::par::count_if(std::as_const(l), cp,
+        [](auto const& s) noexcept { return s < "d"; }) == 3);
+    }
+
+    // exceptions from workers propagate
+    {
+      xl::list l(std::views::iota(0, 1000));
+      bool thrown{};
+
+      try
+      {
+        xl::par::for_each(l, [](int const i) { if (i == 900) throw i; }, 4);
+      }
+      catch (int const i) { thrown = 900 == i; }
+
+      assert(thrown);
+    }
+
+    // a private pool is reused across calls, nested calls do not deadlock
+    {
+      xl::par::pool p(2);
+      assert(2 == p.size());
+
+      xl::list l(std::views::iota(0, 1000));
+
+      for (int k{}; k != 10; ++k)
+        assert(xl::par::count_if(l, [](int const i) noexcept { return i % 2; },
+          4, p) == 500);
+
+      std::atomic<std::size_t> n{};
+
+      xl::par::for_each(l, xl::par::checkpoints(l, 4),
+        [&](int const i)
+        {
+          if (!(i % 250))
+            n += xl::par::count_if(std::as_const(l),
+              [](int const i) noexcept { return i < 10; }, 3, p);
+        }, 4, p);
+
+      assert(40 == n);
+    }
+  }
+
+  // ─── TC-37  parallel mutating algorithms ─────────────────────────────────────
+  {
+    std::mt19937 rng(37);
+
+    for (int n: {0, 1, 2, 5, 100, 10000})
+      for (std::size_t t: {1, 2, 3, 8})
+      {
+        std::vector<int> v(n);
+        for (auto& e: v) e = int(rng() % 4); // long runs of duplicates
+
+        auto const valid([](xl::list<int> const& l, std::vector<int> const& v)
+          {
+            return std::ranges::equal(l, v) &&
+              std::ranges::equal(l | std::views::reverse, v | std::views::reverse);
+          });
+
+        auto const odd([](int const i) noexcept { return i % 2; });
+
+        {
+          xl::list l(v.begin(), v.end()), s(l);
+          assert(xl::par::remove_if(l, odd, t) == s.remove_if(odd));
+          assert(valid(l, std::vector<int>(s.begin(), s.end())));
+        }
+
+        {
+          xl::list l(v.begin(), v.end()), s(l);
+          assert(xl::par::unique(l, std::equal_to<>(), t) == s.unique());
+          assert(valid(l, std::vector<int>(s.begin(), s.end())));
+
+          xl::list c(std::vector<int>(n, 7));
+          assert(xl::par::unique(c, std::equal_to<>(), t) == std::size_t(n ? n - 1 : 0));
+          assert(c.size() == std::size_t(!!n));
+        }
+
+        { // a predicate that is not transitive
+          auto const near([](int const a, int const b) noexcept
+            {
+              return std::abs(a - b) <= 1;
+            }
+          );
+
+          xl::list l(v.begin(), v.end()), s(l);
+          assert(xl::par::unique(l, near, t) == s.unique(near));
+          assert(valid(l, std::vector<int>(s.begin(), s.end())));
+
+          for (auto const& w: {std::vector{1, 2, 3}, std::vector{1, 2, 3, 4, 5},
+            std::vector{3, 2, 1, 2, 3, 2, 1}})
+          {
+            xl::list m(w.begin(), w.end()), u(m);
+            assert(xl::par::unique(m, near, t) == u.unique(near));
+            assert(valid(m, std::vector<int>(u.begin(), u.end())));
+          }
+        }
+
+        {
+          xl::list l(v.begin(), v.end());
+          auto w(v);
+          auto const p(xl::par::stable_partition(l, odd, t));
+          auto const q(std::stable_partition(w.begin(), w.end(), odd));
+          assert(valid(l, w));
+          assert(std::distance(l.begin(), p) == q - w.begin());
+        }
+      }
+
+    // a throwing predicate keeps every element
+    {
+      xl::list l(std::views::iota(0, 1000));
+
+      try
+      {
+        xl::par::remove_if(l, [](int const i) { if (i == 700) throw i; return i % 2; }, 4);
+      }
+      catch (int) { }
+
+      assert(std::ranges::is_sorted(l) && (std::ranges::find(l, 700) != l.end()) &&
+        500 == std::ranges::count_if(l, [](int const i) { return !(i % 2); }));
+    }
+
+    // a pred throwing in one worker keeps every element, and both orders
+    {
+      xl::list l(std::views::iota(0, 1000));
+      bool thrown{};
+
+      try
+      {
+        xl::par::stable_partition(l,
+          [](int const i) { if (i == 700) throw i; return i % 2; }, 4);
+      }
+      catch (int) { thrown = true; }
+
+      auto const odd([](int const i) noexcept { return i % 2; });
+
+      assert(thrown && 1000 == l.size());
+      assert(std::ranges::is_sorted(l | std::views::filter(odd)));
+      assert(std::ranges::is_sorted(l | std::views::filter(std::not_fn(odd))));
+
+      std::vector<int> v(l.begin(), l.end());
+      assert(std::ranges::equal(l | std::views::reverse, v | std::views::reverse));
+
+      std::ranges::sort(v);
+      assert(std::ranges::equal(v, std::views::iota(0, 1000)));
+    }
+  }
+
+  // ─── TC-38  parallel bulk construction ───────────────────────────────────────
+  {
+    for (int n: {0, 1, 3, 1000})
+      for (std::size_t t: {1, 2, 7})
+      {
+        auto const l(xl::par::make_list(std::views::iota(0, n), t));
+        assert(std::ranges::equal(l, std::views::iota(0, n)));
+        assert(std::ranges::equal(l | std::views::reverse,
+          std::views::iota(0, n) | std::views::reverse));
+
+        xl::list<int> a{-2, -1};
+        xl::par::append_range(a, std::views::iota(0, n), t);
+        assert(a.size() == std::size_t(n + 2) && std::ranges::is_sorted(a));
+        assert(-2 == a.front() && (n ? n - 1 : -1) == a.back());
+      }
+
+    // rvalue sources are moved from
+    std::vector<std::string> v(100, std::string(64, 'x'));
+    auto const l(xl::par::make_list(std::move(v), 4));
+    assert(100 == l.size() && std::ranges::all_of(v, &std::string::empty));
+  }
+
+  // ─── TC-39  mpsc_queue ───────────────────────────────────────────────────────
+  {
+    xl::mpsc_queue<std::pair<int, int>> q;
+    assert(q.empty() && q.drain().empty());
+
+    int constexpr P(4), N(10000);
+
+    std::vector<std::thread> ps;
+
+    for (int p{}; p != P; ++p)
+      ps.emplace_back([&q, p]
+        {
+          decltype(q)::producer s(q);
+
+          for (int i{}; i != N; ++i)
+          {
+            if (i % 3) s.emplace(p, i); else q.push({p, i}); // unstaged push
+
+            if (!(i % 64)) s.flush();
+          }
+        }
+      );
+
+    std::vector<std::vector<int>> got(P);
+
+    for (std::size_t n{}; n != std::size_t(P * N);)
+      for (auto const& [p, i]: q.drain()) got[p].push_back(i), ++n;
+
+    for (auto& t: ps) t.join();
+
+    assert(std::as_const(q).empty());
+
+    for (auto& g: got)
+    { // nothing lost or duplicated
+      assert(std::size_t(N) == g.size());
+      std::ranges::sort(g);
+      assert(std::ranges::equal(g, std::views::iota(0, N)));
+    }
+
+    { // a producer flushes on destruction, batches keep their order
+      {
+        decltype(q)::producer s(q);
+        for (int i{}; i != 5; ++i) s.push({0, i});
+        assert(!s.empty() && q.empty());
+      }
+
+      auto const l(q.drain());
+      assert(std::ranges::equal(l | std::views::values, std::views::iota(0, 5)));
+    }
+  }
+
+  // ─── TC-40  coroutine channel ────────────────────────────────────────────────
+  {
+    for (std::size_t c: {std::size_t(0), std::size_t(1), std::size_t(3),
+      std::numeric_limits<std::size_t>::max()})
+    {
+      xl::executor ex;
+      xl::channel<std::string> ch(ex, c);
+
+      std::vector<std::string> got;
+      bool ok{true};
+
+      auto const producer([](xl::channel<std::string>& ch, bool& ok, int p) -> xl::task
+        {
+          for (int i{}; i != 100; ++i)
+            ok = co_await ch.send(std::to_string(p) + ':' + std::to_string(i)) && ok;
+        });
+
+      auto const consumer([](xl::channel<std::string>& ch,
+        std::vector<std::string>& got) -> xl::task
+        {
+          while (auto v = co_await ch.receive()) got.push_back(std::move(*v));
+        });
+
+      ex.spawn(consumer(ch, got));
+      ex.spawn(producer(ch, ok, 0));
+      ex.spawn(producer(ch, ok, 1));
+      ex.run();
+
+      assert(ok && ch.size() <= c);
+      assert(200 == got.size()); // consumer is parked on an empty channel
+
+      ch.close();
+      ex.run();
+
+      for (int p{}; p != 2; ++p)
+      { // per producer order is kept
+        std::vector<std::string> v;
+        std::ranges::copy_if(got, std::back_inserter(v),
+          [&](auto const& s) { return s.starts_with(std::to_string(p) + ':'); });
+
+        assert(100 == v.size());
+        for (int i{}; i != 100; ++i)
+          assert(v[i] == std::to_string(p) + ':' + std::to_string(i));
+      }
+    }
+
+    // receive_all takes the buffer in one go, sending to a closed channel fails
+    {
+      xl::executor ex;
+      xl::channel<int> ch(ex, 4);
+
+      std::vector<std::size_t> batches;
+      int sent{};
+
+      ex.spawn([](xl::channel<int>& ch, std::vector<std::size_t>& b) -> xl::task
+        {
+          for (;;)
+          {
+            auto const l(co_await ch.receive_all());
+            if (l.empty()) break;
+
+            b.push_back(l.size());
+            assert(std::ranges::is_sorted(l));
+          }
+        }(ch, batches));
+
+      ex.spawn([](xl::channel<int>& ch, int& sent) -> xl::task
+        {
+          for (int i{}; i != 10; ++i) sent += co_await ch.send(i);
+          ch.close();
+          sent += co_await ch.send(10);
+        }(ch, sent));
+
+      ex.run();
+
+      assert(10 == sent && ch.closed());
+      assert(10 == std::accumulate(batches.cbegin(), batches.cend(), std::size_t{}));
+      assert(batches.size() < 10); // batched, not one by one
+    }
+  }
+
+  // ─── TC-41  compact() and fragmentation() ────────────────────────────────────
+  {
+    std::mt19937 rng(41);
+
+    assert(0. == xl::list<int>().fragmentation());
+    assert(0. == xl::list<int>{1}.fragmentation());
+
+    { // cached nodes end up in one block, in chain order
+      xl::list<cached_int> l;
+      for (int i{}; i != 5000; ++i) l.push_back({i});
+
+      l.shuffle(rng);
+      std::vector<cached_int> const v(l.cbegin(), l.cend());
+      assert(l.fragmentation() > .5);
+
+      l.compact();
+      assert(0. == l.fragmentation());
+      assert(std::ranges::equal(l, v));
+      assert(std::ranges::equal(l | std::views::reverse, v | std::views::reverse));
+
+      l.sort();
+      l.erase(std::next(l.cbegin(), 10), std::next(l.cbegin(), 4990));
+      l.push_front({-1});
+      assert(21 == l.size() && (-1 == l.front().v) && (4999 == l.back().v));
+    }
+
+    { // values are moved, not copied
+      xl::list<cached_string> l;
+      for (int i{}; i != 100; ++i) l.push_front({std::string(40, char('a' + i % 26))});
+
+      std::vector<cached_string> const v(l.cbegin(), l.cend());
+
+      l.compact();
+      assert(0. == l.fragmentation());
+      assert(std::ranges::equal(l, v, {}, &cached_string::v, &cached_string::v));
+    }
+
+    { // plain nodes are reallocated in chain order
+      xl::list<int> l(std::views::iota(0, 1000));
+      l.shuffle(rng);
+
+      std::vector<int> const v(l.cbegin(), l.cend());
+
+      l.compact();
+      assert(std::ranges::equal(l, v) && (1000 == l.size()));
+    }
+
+    { // freed runs are reused, repeated compaction does not grow memory
+      using E = cached_padded<8>;
+
+      xl::list<E> l;
+      for (int i{}; i != 1000; ++i) l.push_back({i});
+
+      l.compact();
+      auto const a(&l.front());
+
+      l.compact(); // the first run is still in use
+      assert(&l.front() != a);
+
+      l.compact(); // but free again now
+      assert((&l.front() == a) && (0. == l.fragmentation()));
+      assert(std::ranges::equal(l | std::views::transform(&E::v),
+        std::views::iota(0, 1000)));
+    }
+
+    // a throwing copy leaves the list as it was
+    auto const fragile_compact([](auto l)
+      {
+        for (int i{}; i != 1000; ++i) l.emplace_back(i);
+
+        fragile::budget = 500;
+
+        bool thrown{};
+        try { l.compact(); } catch (int) { thrown = true; }
+
+        fragile::budget = -1;
+
+        assert(thrown && (1000 == l.size()));
+        assert(std::ranges::equal(l | std::views::transform(&fragile::v),
+          std::views::iota(0, 1000)));
+      }
+    );
+
+    fragile_compact(xl::list<fragile>());
+    fragile_compact(xl::list<cached_fragile>());
+  }
+
+  // ─── TC-42  inserts placed near their neighbors ──────────────────────────────
+  {
+    using E = cached_padded<16>;
+
+    xl::list<E> l;
+    for (int i{}; i != 1000; ++i) l.push_back({2 * i});
+
+    l.compact();
+
+    // every 8th node is followed by a spare, inserts there stay in order
+    for (auto i(std::next(l.cbegin(), 8)); l.cend() != i;
+      i = std::next(i, std::min(9, int(std::distance(i, l.cend())))))
+      i = l.insert(i, {i->v - 1});
+
+    assert(1124 == l.size() && (0. == l.fragmentation()));
+    assert(std::ranges::is_sorted(l, {}, &E::v));
+
+    { // once the spares near a node are used up, inserts go elsewhere
+      auto i(std::next(l.cbegin(), 500));
+      auto const v(i->v);
+
+      for (int j{}; j != 100; ++j) i = l.insert(i, {v - 1});
+
+      assert(1224 == l.size() && std::ranges::is_sorted(l, {}, &E::v));
+      assert(l.fragmentation() > 0.);
+    }
+
+    { // the far end of a run and an empty list work as well
+      l.insert(l.cend(), {1 << 20});
+      l.emplace_front(E{-1});
+      assert(-1 == l.front().v && ((1 << 20) == l.back().v));
+
+      xl::list<E> m;
+      m.insert(m.cend(), {1});
+      assert(1 == m.size());
+    }
+
+    { // fresh slabs reserve spares too, no compaction needed
+      using F = cached_padded<40>;
+
+      xl::list<F> m;
+      for (int i{}; i != 1000; ++i) m.push_back({2 * i});
+
+      auto const far([](F const& a, F const& b) noexcept
+        {
+          auto const d(reinterpret_cast<char const*>(&a) -
+            reinterpret_cast<char const*>(&b));
+          return std::size_t(d < 0 ? -d : d) >= 64 * (sizeof(F) + sizeof(F*));
+        }
+      );
+
+      for (auto i(std::next(m.cbegin(), 5)); m.cend() != i;
+        i = std::next(i, std::min(11, int(std::distance(i, m.cend())))))
+      {
+        i = m.insert(i, {i->v - 1});
+        assert(!far(*i, *std::next(i)));
+      }
+
+      assert(1100 == m.size() && std::ranges::is_sorted(m, {}, &F::v));
+    }
+  }
 }
 
 int main()
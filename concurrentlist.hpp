@@ -0,0 +1,302 @@
+#ifndef XL_CONCURRENTLIST_HPP
+# define XL_CONCURRENTLIST_HPP
+# pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "list.hpp"
+
+namespace xl
+{
+
+template <typename T>
+class concurrent_list
+{ // the chain is cut into segments, each with its own lock, a directory
+  // lock is held shared by every operation and exclusively only while
+  // segments are split or merged
+public:
+  using value_type = T;
+  using size_type = typename list<T>::size_type;
+
+private:
+  struct segment
+  {
+    std::mutex m_;
+    list<T> l_;
+    std::atomic<size_type> n_{};
+  };
+
+  using directory = std::vector<std::unique_ptr<segment>>;
+
+  size_type const s_; // target segment size
+  mutable std::shared_mutex m_;
+  directory d_;
+
+  bool unbalanced(segment const& g) const noexcept
+  { // too big, or too small with a neighbour to merge into
+    auto const n(g.n_.load(std::memory_order_relaxed));
+    return (n > 2 * s_) || ((4 * n < s_) && (d_.size() > 1));
+  }
+
+  void rebalance(segment const* const g)
+  { // with the directory locked exclusively no segment lock is held
+    std::unique_lock const l(m_);
+
+    auto i(std::ranges::find(d_, g,
+      [](auto& p) noexcept { return p.get(); }));
+    if ((d_.end() == i) || !unbalanced(**i)) [[unlikely]] return;
+
+    if (auto& a(**i); a.n_ <= 2 * s_)
+    { // merge into a neighbour
+      auto const j(d_.end() == std::next(i) ? std::prev(i) : std::next(i));
+      auto& b(**j);
+
+      bool const left(j < i);
+
+      b.l_.splice(left ? b.l_.cend() : b.l_.cbegin(), a.l_);
+      b.n_ += a.n_;
+
+      i = std::prev(d_.erase(i), left);
+      if ((*i)->n_ <= 2 * s_) return;
+    }
+
+    // split in half
+    auto& a(**i);
+    auto b(std::make_unique<segment>());
+
+    auto const h(a.n_ / 2);
+    b->l_ = a.l_.split(std::next(a.l_.cbegin(), h));
+    b->n_ = a.n_ - h; a.n_ = h;
+
+    d_.insert(std::next(i), std::move(b));
+  }
+
+  auto& at(size_type& i) const noexcept
+  { // the segment holding index i, i becomes segment relative
+    for (auto& g: d_)
+      if (auto const n(g->n_.load(std::memory_order_relaxed)); i <= n)
+        return *g;
+      else
+        i -= n;
+
+    i = d_.back()->n_.load(std::memory_order_relaxed); // clamp
+
+    return *d_.back();
+  }
+
+  template <class F>
+  auto edit(auto&& s, F&& f)
+  { // f(segment&) under its lock, the segment is chosen by s(directory)
+    segment* g;
+    bool u;
+
+    auto r([&]
+      {
+        std::shared_lock const l(m_);
+        std::lock_guard const k((g = &s(std::as_const(d_)))->m_);
+
+        if constexpr(std::is_void_v<std::invoke_result_t<F&, segment&>>)
+          return f(*g), u = unbalanced(*g);
+        else
+        {
+          auto v(f(*g));
+          u = unbalanced(*g);
+
+          return v;
+        }
+      }()
+    );
+
+    if (u) rebalance(g); // g may be gone by now, it is only looked up
+
+    if constexpr(std::is_void_v<std::invoke_result_t<F&, segment&>>)
+      return;
+    else
+      return r;
+  }
+
+public:
+  explicit concurrent_list(size_type const s = 256):
+    s_(std::max(s, size_type(1)))
+  {
+    d_.push_back(std::make_unique<segment>());
+  }
+
+  concurrent_list(concurrent_list const&) = delete;
+  concurrent_list& operator=(concurrent_list const&) = delete;
+
+  //
+  void emplace(size_type i, auto&& ...a)
+  { // clamped to the end
+    edit([&](auto&) -> auto& { return at(i); },
+      [&](segment& g)
+      { // sizes may have changed since at()
+        g.l_.emplace(std::next(g.l_.cbegin(), std::min(i, size_type(g.n_))),
+          std::forward<decltype(a)>(a)...);
+        ++g.n_;
+      }
+    );
+  }
+
+  void emplace_back(auto&& ...a)
+  {
+    edit([](auto& d) -> auto& { return *d.back(); },
+      [&](segment& g)
+      {
+        g.l_.emplace_back(std::forward<decltype(a)>(a)...); ++g.n_;
+      }
+    );
+  }
+
+  void emplace_front(auto&& ...a)
+  {
+    edit([](auto& d) -> auto& { return *d.front(); },
+      [&](segment& g)
+      {
+        g.l_.emplace_front(std::forward<decltype(a)>(a)...); ++g.n_;
+      }
+    );
+  }
+
+  void insert(size_type const i, value_type const& v) { emplace(i, v); }
+  void insert(size_type const i, value_type&& v) { emplace(i, std::move(v)); }
+
+  void push_back(value_type const& v) { emplace_back(v); }
+  void push_back(value_type&& v) { emplace_back(std::move(v)); }
+  void push_front(value_type const& v) { emplace_front(v); }
+  void push_front(value_type&& v) { emplace_front(std::move(v)); }
+
+  //
+  std::optional<value_type> pop_back()
+  { // retried if the chosen segment was emptied before it was locked
+    auto const s([](auto& d) -> auto&
+      { // the last non-empty segment, sizes are only a hint
+        auto const i(std::ranges::find_if(d | std::views::reverse,
+          [](auto& g) noexcept { return g->n_.load(std::memory_order_relaxed); }));
+
+        return **(d.rend() == i ? d.rbegin() : i);
+      }
+    );
+
+    auto const f([](segment& g)
+      {
+        std::optional<value_type> r;
+
+        if (!g.l_.empty())
+        {
+          r.emplace(std::move(g.l_.back()));
+          g.l_.pop_back(); --g.n_;
+        }
+
+        return r;
+      }
+    );
+
+    for (;;) if (auto r(edit(s, f)); r || !size()) return r;
+  }
+
+  std::optional<value_type> pop_front()
+  {
+    auto const s([](auto& d) -> auto&
+      {
+        auto const i(std::ranges::find_if(d,
+          [](auto& g) noexcept { return g->n_.load(std::memory_order_relaxed); }));
+
+        return **(d.end() == i ? d.begin() : i);
+      }
+    );
+
+    auto const f([](segment& g)
+      {
+        std::optional<value_type> r;
+
+        if (!g.l_.empty())
+        {
+          r.emplace(std::move(g.l_.front()));
+          g.l_.pop_front(); --g.n_;
+        }
+
+        return r;
+      }
+    );
+
+    for (;;) if (auto r(edit(s, f)); r || !size()) return r;
+  }
+
+  //
+  void for_each(auto f)
+  { // one segment locked at a time
+    std::shared_lock const l(m_);
+
+    for (auto& g: d_)
+    {
+      std::lock_guard const k(g->m_);
+      for (auto& v: g->l_) f(v);
+    }
+  }
+
+  size_type remove_if(auto pred)
+  { // one segment locked at a time, empty segments are dropped afterwards,
+    // small ones are merged when next edited
+    size_type r{};
+
+    {
+      std::shared_lock const l(m_);
+
+      for (auto& g: d_)
+      {
+        std::lock_guard const k(g->m_);
+
+        auto const n(g->l_.remove_if(pred));
+        g->n_ -= n; r += n;
+      }
+    }
+
+    if (r)
+    {
+      std::unique_lock const l(m_);
+
+      std::erase_if(d_, [](auto& g) noexcept { return !g->n_; });
+      if (d_.empty()) d_.push_back(std::make_unique<segment>());
+    }
+
+    return r;
+  }
+
+  //
+  [[nodiscard]] size_type segments() const
+  {
+    std::shared_lock const l(m_);
+    return d_.size();
+  }
+
+  [[nodiscard]] size_type size() const
+  { // a snapshot, exact when quiescent
+    std::shared_lock const l(m_);
+
+    size_type r{};
+    for (auto& g: d_) r += g->n_.load(std::memory_order_relaxed);
+
+    return r;
+  }
+
+  [[nodiscard]] list<T> take()
+  { // the whole chain, concurrent_list is left empty
+    std::unique_lock const l(m_);
+
+    list<T> r;
+
+    for (auto& g: d_) r.splice(r.cend(), g->l_), g->n_ = {};
+    d_.resize(1);
+
+    return r;
+  }
+};
+
+}
+
+#endif // XL_CONCURRENTLIST_HPP
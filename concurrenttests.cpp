@@ -0,0 +1,434 @@
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "concurrentlist.hpp"
+#include "ebrlist.hpp"
+#include "mpscqueue.hpp"
+#include "reclaimer.hpp"
+
+struct plain { long v; };
+struct cached { long v; };
+
+template <> inline constexpr bool xl::cache_nodes<cached>{true};
+
+xl::list<cached> leftovers; // freed after main's node cache is gone
+thread_local xl::list<cached> late; // likewise, for its thread
+
+struct locked_list
+{ // the baseline, one mutex around an xl::list
+  std::mutex m_;
+  xl::list<int> l_;
+
+  void insert(std::size_t i, int const v)
+  { // clamped to the end
+    std::lock_guard const g(m_);
+
+    auto j(l_.cbegin());
+    for (; i && (l_.cend() != j); --i, ++j);
+
+    l_.insert(j, v);
+  }
+
+  auto pop_back()
+  {
+    std::lock_guard const g(m_);
+
+    std::optional<int> r;
+    if (!l_.empty()) r = l_.back(), l_.pop_back();
+
+    return r;
+  }
+
+  auto pop_front()
+  {
+    std::lock_guard const g(m_);
+
+    std::optional<int> r;
+    if (!l_.empty()) r = l_.front(), l_.pop_front();
+
+    return r;
+  }
+
+  void push_back(int const v) { std::lock_guard const g(m_); l_.push_back(v); }
+  void push_front(int const v) { std::lock_guard const g(m_); l_.push_front(v); }
+
+  auto size() { std::lock_guard const g(m_); return l_.size(); }
+};
+
+void correctness()
+{
+  xl::concurrent_list<int> l(16);
+
+  int constexpr T(4), N(20000);
+
+  {
+    std::vector<std::jthread> ts;
+
+    for (int t{}; t != T; ++t)
+      ts.emplace_back([&l, t]
+        {
+          for (int i{}; i != N; ++i)
+            switch (auto const v(t * N + i); t)
+            {
+              case 0: l.push_back(v); break;
+              case 1: l.push_front(v); break;
+              default: l.insert(v % 1000, v);
+            }
+        }
+      );
+  }
+
+  assert(std::size_t(T * N) == l.size() && l.segments() > 1);
+
+  std::vector<int> v;
+  l.for_each([&](int const i) { v.push_back(i); });
+
+  auto const c(l.take());
+  assert(std::ranges::equal(c, v) && !l.size() && (1 == l.segments()));
+
+  // back and front pushers keep their order
+  auto const tagged([&](int const t)
+    {
+      std::vector<int> r;
+      std::ranges::copy_if(v, std::back_inserter(r),
+        [&](int const i) noexcept { return i / N == t; });
+      return r;
+    });
+
+  assert(std::ranges::is_sorted(tagged(0)));
+  assert(std::ranges::is_sorted(tagged(1), std::greater<>()));
+
+  std::ranges::sort(v);
+  assert(std::ranges::equal(v, std::views::iota(0, T * N)));
+
+  // concurrent pops drain everything exactly once, segments merge back
+  for (auto const i: c) l.push_back(i);
+
+  {
+    std::vector<std::vector<int>> got(T);
+    std::vector<std::jthread> ts;
+
+    for (int t{}; t != T; ++t)
+      ts.emplace_back([&l, &g = got[t], t]
+        {
+          while (auto const v = t % 2 ? l.pop_back() : l.pop_front())
+            g.push_back(*v);
+        }
+      );
+
+    ts.clear();
+
+    std::vector<int> all;
+    for (auto& g: got) all.insert(all.end(), g.begin(), g.end());
+
+    std::ranges::sort(all);
+    assert(std::ranges::equal(all, std::views::iota(0, T * N)));
+  }
+
+  assert(!l.size() && (1 == l.segments()) && !l.pop_front());
+
+  // remove_if
+  for (int i{}; i != 1000; ++i) l.push_back(i);
+  assert(500 == l.remove_if([](int const i) noexcept { return i % 2; }));
+  assert(500 == l.size());
+}
+
+void ebr()
+{ // one writer appends and removes, readers must always see an ascending
+  // chain
+  xl::ebr_domain d;
+
+  {
+    xl::ebr_list<int> l(d);
+
+    std::atomic<bool> done{};
+    std::atomic<std::size_t> scans{};
+
+    std::vector<std::jthread> ts;
+
+    for (int t{}; t != 3; ++t)
+      ts.emplace_back([&]
+        {
+          do
+          {
+            std::optional<int> last;
+
+            l.for_each([&](int const i)
+              {
+                assert(!last || (*last < i));
+                last = i;
+              }
+            );
+
+            ++scans;
+          }
+          while (!done.load(std::memory_order_relaxed));
+        }
+      );
+
+    for (int i{}; i != 50000; ++i)
+    {
+      l.push_back(i);
+
+      switch (i % 16)
+      {
+        case 5: l.pop_front(); break;
+        case 9: l.pop_back(); break;
+        case 15:
+          l.remove_if([i](int const j) noexcept { return (j % 3) && (j > i - 64); });
+          l.collect();
+      }
+    }
+
+    done = true;
+    ts.clear();
+
+    assert(scans >= 3);
+
+    std::vector<int> v;
+    l.for_each([&](int const i) { v.push_back(i); });
+    assert(!v.empty() && std::ranges::is_sorted(v));
+
+    l.clear();
+    assert(l.empty());
+  }
+
+  d.collect(); d.collect(); d.collect(); // nothing pinned, everything freed
+}
+
+void bench(auto& l, std::size_t const t, int const n, bool const mid)
+{ // edits at both ends, with mid inserts if asked, those walk up to 4096
+  // nodes in the locked list, but only the directory and one segment in
+  // concurrent_list, so they measure different algorithms as well
+  auto const start(std::chrono::high_resolution_clock::now());
+
+  {
+    std::vector<std::jthread> ts;
+
+    for (std::size_t j{}; j != t; ++j)
+      ts.emplace_back([&l, j, n, mid]
+        {
+          std::minstd_rand g(j);
+
+          for (int i{}; i != n; ++i)
+            switch (g() % 8)
+            {
+              case 0: case 1: case 2: l.push_back(i); break;
+              case 3: case 4: l.push_front(i); break;
+              case 5:
+                if (auto const k(g() % 4096); mid) l.insert(k, i);
+                else l.push_back(i);
+                break;
+              case 6: l.pop_back(); break;
+              default: l.pop_front();
+            }
+        }
+      );
+  }
+
+  std::cout << t << " threads: " <<
+    std::chrono::duration<double>(
+      std::chrono::high_resolution_clock::now() - start).count() <<
+    " s, " << l.size() << " left" << std::endl;
+}
+
+void deferred()
+{
+  static std::atomic<long> alive;
+  static thread_local long here; // old elements destroyed on this thread
+
+  struct counted
+  {
+    bool old{};
+
+    counted() noexcept { ++alive; }
+    counted(counted const&) noexcept { ++alive; }
+    ~counted() { --alive; here += old; }
+  };
+
+  {
+    xl::reclaimer r(100, std::chrono::microseconds(10)); // throttled
+
+    xl::list<counted> l(1000);
+    assert(1000 == alive);
+
+    xl::deferred_destroy(std::move(l), r);
+    assert(l.empty());
+
+    r.wait();
+    assert(!alive);
+
+    // still queued lists are destroyed with the reclaimer
+    for (int i{}; i != 10; ++i) r.post(xl::list<counted>(1000));
+  }
+
+  assert(!alive);
+
+  { // a caller supplied executor
+    std::vector<std::function<void()>> jobs;
+
+    xl::list<counted> l(10);
+    xl::deferred_destroy(std::move(l), [&](auto f) { jobs.push_back(std::move(f)); });
+    assert(l.empty() && (10 == alive) && (1 == jobs.size()));
+
+    jobs.front()();
+    assert(!alive);
+  }
+
+  { // a deferred list
+    {
+      xl::deferred<xl::list<counted>> l(500);
+      assert(500 == alive);
+    }
+
+    xl::reclaimer::global().wait();
+    assert(!alive);
+
+    { // assigning, clearing and shrinking defer the old nodes as well
+      auto const aged([](auto& l) -> auto&
+        {
+          for (auto& e: l) e.old = true;
+          return l;
+        }
+      );
+
+      here = 0;
+
+      xl::list<counted> const src(100);
+      xl::deferred<xl::list<counted>> l(500), m(300);
+
+      aged(l) = std::move(m);
+      assert(300 == l.size() && m.empty());
+      aged(l) = m;
+      assert(l.empty());
+
+      l.resize(200);
+      aged(l).resize(50);
+      assert(50 == l.size());
+
+      aged(l).assign(src.begin(), src.end());
+      assert(100 == l.size());
+      aged(l).assign(20, counted());
+      assert(20 == l.size());
+      aged(l).assign_range(src);
+      assert(100 == l.size());
+      aged(l) = src;
+      assert(100 == l.size());
+      aged(l) = {counted(), counted()};
+      assert(2 == l.size());
+
+      aged(l).clear();
+      assert(l.empty());
+    }
+
+    xl::reclaimer::global().wait();
+    assert(!alive && !here);
+  }
+
+  { // the caller only pays for the hand over
+    xl::list<long> a(std::views::iota(0, 10000000)), b(a);
+
+    auto const start(std::chrono::high_resolution_clock::now());
+    a.clear();
+    auto const mid(std::chrono::high_resolution_clock::now());
+    xl::deferred_destroy(std::move(b));
+    auto const end(std::chrono::high_resolution_clock::now());
+
+    std::cout << "=== destroying 10M nodes ===" << std::endl <<
+      "in place: " << std::chrono::duration<double>(mid - start).count() <<
+      " s, deferred: " << std::chrono::duration<double>(end - mid).count() <<
+      " s" << std::endl;
+
+    xl::reclaimer::global().wait();
+  }
+}
+
+template <typename T>
+void queue_bench(int const n)
+{ // nodes are allocated by the producer and freed by the consumer
+  xl::mpsc_queue<T> q;
+
+  auto const start(std::chrono::high_resolution_clock::now());
+
+  long sum{};
+
+  {
+    std::jthread p([&]
+      {
+        typename decltype(q)::producer s(q);
+
+        for (int i{}; i != n; ++i)
+        {
+          s.emplace(T{i});
+          if (!(i % 256)) s.flush();
+        }
+      }
+    );
+
+    for (long k{}; k != n;)
+      for (auto const& e: q.drain()) sum += e.v, ++k;
+  }
+
+  assert(sum == long(n) * (n - 1) / 2);
+
+  std::cout << std::chrono::duration<double>(
+    std::chrono::high_resolution_clock::now() - start).count() << " s" <<
+    std::endl;
+}
+
+int main()
+{
+  correctness();
+  ebr();
+  deferred();
+
+  for (int j{}; j != 2; ++j)
+  {
+    std::cout << "=== queue, new/delete ===" << std::endl;
+    queue_bench<plain>(2000000);
+
+    std::cout << "=== queue, node cache ===" << std::endl;
+    queue_bench<cached>(2000000);
+  }
+
+  { // cached nodes behave like any other
+    xl::list<cached> l;
+    for (long i{}; i != 1000; ++i) l.push_back({i}), l.push_front({-i});
+
+    l.remove_if([](auto const& e) noexcept { return e.v % 3; });
+    assert(668 == l.size());
+
+    xl::list<cached> m(l);
+    l.clear();
+    assert(668 == m.size() && l.empty());
+
+    leftovers.swap(m);
+
+    std::jthread([]
+      {
+        for (long i{}; i != 1000; ++i) late.push_back({i});
+      }
+    );
+  }
+
+  for (bool const mid: {false, true})
+    for (std::size_t t: {1, 2, 4})
+    {
+      auto const mix(mid ? ", ends and middle ===" : ", ends only ===");
+
+      std::cout << "=== locked xl::list" << mix << std::endl;
+      locked_list a;
+      bench(a, t, 100000, mid);
+
+      std::cout << "=== xl::concurrent_list" << mix << std::endl;
+      xl::concurrent_list<int> b;
+      bench(b, t, 100000, mid);
+    }
+
+  return 0;
+}
@@ -0,0 +1,297 @@
+#ifndef XL_EBRLIST_HPP
+# define XL_EBRLIST_HPP
+# pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "listiterator.hpp"
+
+namespace xl
+{
+
+class ebr_domain
+{ // epoch based reclamation, readers pin an epoch, retired memory is freed
+  // two epochs later
+  struct alignas(64) slot
+  {
+    std::atomic<std::uint64_t> e_{}; // 0 or epoch << 1 | 1
+  };
+
+  struct retired
+  {
+    void* p;
+    void (*d)(void*) noexcept;
+    std::uint64_t e;
+  };
+
+  std::atomic<std::uint64_t> e_{};
+  std::array<slot, 64> s_;
+
+  std::mutex m_;
+  std::vector<retired> r_;
+
+public:
+  class guard
+  {
+    friend class ebr_domain;
+    slot& s_;
+
+    explicit guard(slot& s) noexcept: s_(s) { }
+
+  public:
+    guard(guard const&) = delete;
+    guard& operator=(guard const&) = delete;
+
+    ~guard() { s_.e_.store({}, std::memory_order_release); }
+  };
+
+  ebr_domain() = default;
+
+  ebr_domain(ebr_domain const&) = delete;
+  ebr_domain& operator=(ebr_domain const&) = delete;
+
+  ~ebr_domain() { for (auto const& r: r_) r.d(r.p); }
+
+  //
+  static auto& global() noexcept
+  {
+    static ebr_domain d;
+    return d;
+  }
+
+  //
+  void collect()
+  { // advance if every pinned reader is in the current epoch, then free
+    std::lock_guard const l(m_);
+
+    auto e(e_.load(std::memory_order_seq_cst));
+
+    if (std::ranges::all_of(s_, [e](auto& s) noexcept
+      {
+        auto const v(s.e_.load(std::memory_order_seq_cst));
+        return !v || (v >> 1 == e);
+      })) e_.store(++e, std::memory_order_seq_cst);
+
+    auto const i(std::ranges::partition(r_,
+      [e](auto const& r) noexcept { return r.e + 2 > e; }).begin());
+
+    for (auto j(i); r_.end() != j; ++j) j->d(j->p);
+    r_.erase(i, r_.end());
+  }
+
+  [[nodiscard]] guard pin() noexcept
+  { // one CAS per pin, nothing per node
+    for (;; std::this_thread::yield())
+      for (auto& s: s_)
+        if (std::uint64_t z{}; !s.e_.load(std::memory_order_relaxed) &&
+          s.e_.compare_exchange_strong(z,
+            e_.load(std::memory_order_seq_cst) << 1 | 1,
+            std::memory_order_seq_cst))
+        { // the epoch may have moved on before the slot was published
+          for (std::uint64_t e; (e = e_.load(std::memory_order_seq_cst)) !=
+            s.e_.load(std::memory_order_relaxed) >> 1;)
+            s.e_.store(e << 1 | 1, std::memory_order_seq_cst);
+
+          return guard(s);
+        }
+  }
+
+  void retire(void* const p, void (*const d)(void*) noexcept)
+  {
+    std::lock_guard const l(m_);
+    r_.push_back({p, d, e_.load(std::memory_order_seq_cst)});
+  }
+};
+
+template <typename T>
+class ebr_list
+{ // a single writer appends and removes, any number of readers traverse
+  // concurrently, removed nodes are retired to an ebr_domain
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  struct node
+  {
+    std::atomic<std::uintptr_t> l_; // prev ^ next, frozen once retired
+    std::atomic<std::uint64_t> r_{}; // write that retired the node, or 0
+    value_type v_;
+
+    node* link(node const* const p) const noexcept
+    {
+      return (node*)(detail::conv(p) ^ l_.load(std::memory_order_relaxed));
+    }
+
+    void relink(auto const ...n) noexcept
+    { // only the writer calls this
+      l_.store(l_.load(std::memory_order_relaxed) ^ detail::conv(n...),
+        std::memory_order_relaxed);
+    }
+
+    static void destroy(void* const p) noexcept { delete static_cast<node*>(p); }
+  };
+
+  ebr_domain& d_;
+  std::atomic<node*> f_{}, l_{};
+  std::atomic<std::uint64_t> s_{}; // a seqlock, odd while writing
+
+  void write(auto const f)
+  {
+    auto const s(s_.load(std::memory_order_relaxed) + 1);
+
+    s_.store(s, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    f(s);
+
+    s_.store(s + 1, std::memory_order_release);
+  }
+
+  void unlink(node* const n, node* const p, node* const x)
+  { // the writer erases n between p and x
+    write([&](auto const s) noexcept
+      {
+        p ? p->relink(n, x) : f_.store(x, std::memory_order_relaxed);
+        x ? x->relink(n, p) : l_.store(p, std::memory_order_relaxed);
+
+        n->r_.store(s, std::memory_order_relaxed);
+      }
+    );
+
+    d_.retire(n, node::destroy);
+  }
+
+  static node* resync(node* p, node const* const n) noexcept
+  { // p retired before n, or with n live, had n as its next when retired
+    for (std::uint64_t r; p && (r = p->r_.load(std::memory_order_relaxed));)
+      if (auto const q(n->r_.load(std::memory_order_relaxed)); !q || (r < q))
+        p = p->link(n);
+      else
+        break;
+
+    return p;
+  }
+
+public:
+  explicit ebr_list(ebr_domain& d = ebr_domain::global()) noexcept: d_(d) { }
+
+  ebr_list(ebr_list const&) = delete;
+  ebr_list& operator=(ebr_list const&) = delete;
+
+  ~ebr_list()
+  { // no readers may remain
+    for (node* p{}, *n(f_.load(std::memory_order_relaxed)); n; delete p)
+      detail::assign(p, n)(n, n->link(p));
+  }
+
+  // writer
+  auto& emplace_back(auto&& ...a)
+  {
+    auto const l(l_.load(std::memory_order_relaxed));
+    auto const n(new node{detail::conv(l),
+      {}, value_type(std::forward<decltype(a)>(a)...)});
+
+    write([&](auto) noexcept
+      {
+        l ? l->relink(nullptr, n) : f_.store(n, std::memory_order_relaxed);
+        l_.store(n, std::memory_order_relaxed);
+      }
+    );
+
+    return n->v_;
+  }
+
+  void push_back(value_type const& v) { emplace_back(v); }
+  void push_back(value_type&& v) { emplace_back(std::move(v)); }
+
+  void pop_back()
+  {
+    auto const n(l_.load(std::memory_order_relaxed));
+    unlink(n, n->link(nullptr), nullptr);
+  }
+
+  void pop_front()
+  {
+    auto const n(f_.load(std::memory_order_relaxed));
+    unlink(n, nullptr, n->link(nullptr));
+  }
+
+  size_type remove_if(auto pred)
+  {
+    size_type r{};
+
+    for (node* p{}, *n(f_.load(std::memory_order_relaxed)); n;)
+      if (auto const x(n->link(p)); pred(std::as_const(n->v_)))
+        unlink(n, p, x), ++r, n = x;
+      else
+        p = n, n = x;
+
+    return r;
+  }
+
+  void clear()
+  {
+    while (!empty()) pop_front();
+  }
+
+  void collect() { d_.collect(); } // frees what no reader can see anymore
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return !f_.load(std::memory_order_relaxed);
+  }
+
+  // readers
+  void for_each(auto f) const
+  { // zero atomic RMW per node, steps are validated against the seqlock
+    auto const g(d_.pin());
+
+    auto const begin([this]() noexcept
+      {
+        for (;; std::this_thread::yield())
+          if (auto const s(s_.load(std::memory_order_acquire)); !(s & 1))
+            return s;
+      }
+    );
+
+    auto const valid([this](auto const s) noexcept
+      {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return s_.load(std::memory_order_relaxed) == s;
+      }
+    );
+
+    node* p{}, *n;
+
+    for (std::uint64_t s; s = begin(), n = f_.load(std::memory_order_relaxed),
+      !valid(s););
+
+    while (n)
+    {
+      f(std::as_const(n->v_));
+
+      for (;;)
+      { // p may have been retired, checking it costs one plain load
+        auto const s(begin());
+
+        if (auto const x(n->link(resync(p, n))); valid(s))
+        {
+          detail::assign(p, n)(n, x);
+
+          break;
+        }
+      }
+    }
+  }
+};
+
+}
+
+#endif // XL_EBRLIST_HPP
@@ -4,17 +4,31 @@
 
 #include <climits> // CHAR_BIT
 #include <cstdint> // std::uintptr_t
+#include <cstring> // std::memcpy()
 #include <algorithm> // std::move()
 #include <bit> // std::bit_width()
 #include <compare> // std::three_way_comparable
+#include <functional> // std::hash
 #include <initializer_list>
+#include <random> // std::uniform_int_distribution
 #include <ranges>
+#include <vector>
 
 #include "listiterator.hpp"
+#include "nodecache.hpp"
 
 namespace xl
 {
 
+namespace detail
+{
+
+template <class C, typename T>
+concept three_way_comparator = !std::is_void_v<std::common_comparison_category_t<
+  std::invoke_result_t<C&, T const&, T const&>>>;
+
+}
+
 struct from_range_t { explicit from_range_t() = default; };
 inline constexpr from_range_t from_range{};
 
@@ -60,12 +74,64 @@ private:
     {
     }
 
+    //
+    static void* operator new(std::size_t const sz)
+    {
+      if constexpr(cache_nodes<T>)
+        return detail::node_cache<sizeof(node), alignof(node)>::allocate();
+      else
+        return ::operator new(sz);
+    }
+
+    static void* operator new(std::size_t const sz, std::align_val_t const a)
+    {
+      if constexpr(cache_nodes<T>)
+        return detail::node_cache<sizeof(node), alignof(node)>::allocate();
+      else
+        return ::operator new(sz, a);
+    }
+
+    static void* operator new(std::size_t, node const* const h)
+      requires(cache_nodes<T>)
+    { // near h
+      return detail::node_cache<sizeof(node), alignof(node)>::allocate(h);
+    }
+
+    static void operator delete(void* const p) noexcept
+    {
+      if constexpr(cache_nodes<T>)
+        detail::node_cache<sizeof(node), alignof(node)>::deallocate(p);
+      else
+        ::operator delete(p);
+    }
+
+    static void operator delete(void* const p, std::align_val_t const a)
+      noexcept
+    {
+      if constexpr(cache_nodes<T>)
+        detail::node_cache<sizeof(node), alignof(node)>::deallocate(p);
+      else
+        ::operator delete(p, a);
+    }
+
+    static void operator delete(void* const p, node const*) noexcept
+      requires(cache_nodes<T>)
+    {
+      detail::node_cache<sizeof(node), alignof(node)>::deallocate(p);
+    }
+
     //
     static void destroy(const_iterator i) noexcept(noexcept(delete i.p_))
     {
       while (i) delete (++i).p_;
     }
 
+    static void destroy(const_iterator i, const_iterator const e)
+      noexcept(noexcept(delete i.p_))
+    { // [i, e) must already be unlinked from its neighbors
+      while (i != e) delete (++i).p_;
+    }
+
     //
     auto link(auto* const ...n) const noexcept requires(sizeof...(n) < 2)
     {
@@ -146,6 +212,44 @@ private:
       ni.n_->l_ = detail::conv(ni.p_, k.n_); // link ni to k, ni.p_ is valid
     }
 
+    static void merge3(const_iterator& a, const_iterator const b,
+      const_iterator const c, decltype(a) d, auto cmp)
+      noexcept(noexcept(cmp(*b, *b)))
+    { // merge detached runs [a, b) and [c, d) block-wise, cmp is three-way,
+      // every element is still compared once, but a block of consecutive
+      // elements from one run, equal keys included, costs a single relink
+      auto s(a), o(c);
+      bool l(cmp(*o, *s) >= 0); // is s in the left run?
+
+      if (!l) std::swap(s, o);
+      a.n_ = s.n_; // new head
+
+      for (;;)
+      {
+        // take a block from s, left elements go first among equal keys
+        do ++s; while (s && (l ? cmp(*s, *o) <= 0 : cmp(*s, *o) < 0));
+
+        auto const t(s.p_); // block tail
+
+        if (!s) // s is exhausted, append the rest of o
+        {
+          t->l_ ^= detail::conv(o.n_);
+          o.n_->l_ ^= detail::conv(o.p_, t);
+
+          if (!l) d.p_ = b.p_; // the tail of the left run is the new tail
+
+          break;
+        }
+
+        // relink block tail t to o.n_ with a single relink
+        t->l_ ^= detail::conv(s.n_, o.n_);
+        o.n_->l_ ^= detail::conv(o.p_, t);
+        o.p_ = t;
+
+        std::swap(s, o); l = !l;
+      }
+    }
+
     static void insertion_sort(auto& i, decltype(i) j, auto cmp)
       noexcept(noexcept(cmp(*i, *i)) && noexcept(splice(i, i)))
     {
@@ -219,6 +323,39 @@ private:
     }
   };
 
+public:
+  class node_type
+  { // node handle, owns an extracted node
+    friend class list;
+
+    node* n_{};
+
+    explicit node_type(node* const n) noexcept: n_(n) { }
+
+  public:
+    using value_type = list::value_type;
+
+    node_type() = default;
+
+    node_type(node_type&& o) noexcept: n_(std::exchange(o.n_, {})) { }
+
+    ~node_type() noexcept(noexcept(delete n_)) { delete n_; }
+
+    node_type& operator=(node_type&& o) noexcept(noexcept(delete n_))
+    {
+      if (this != std::addressof(o)) delete n_, n_ = std::exchange(o.n_, {});
+      return *this;
+    }
+
+    explicit operator bool() const noexcept { return n_; }
+    [[nodiscard]] bool empty() const noexcept { return !n_; }
+
+    auto& value() const noexcept { return n_->v_; }
+
+    void swap(node_type& o) noexcept { std::swap(n_, o.n_); }
+    friend void swap(node_type& a, node_type& b) noexcept { a.swap(b); }
+  };
+
 private:
   node* f_{}, *l_{};
 
@@ -324,6 +461,20 @@ public:
 
   bool empty() const noexcept { return !f_; }
 
+  [[nodiscard]] double fragmentation() const noexcept
+  { // share of links that are not a short forward step in memory, 0 is
+    // chain order, 1 is no locality at all
+    size_type n{}, f{};
+
+    for (auto i(cbegin()); i.n_ != l_; ++n)
+    {
+      auto const a(detail::conv(i.n_));
+      f += detail::conv((++i).n_) - a > 2 * sizeof(node);
+    }
+
+    return n ? double(f) / n : 0.;
+  }
+
   [[nodiscard]] size_type size() const noexcept
   {
     size_type sz(!empty());
@@ -451,13 +602,92 @@ public:
     node::destroy(cbegin()); detail::assign(f_, l_)(nullptr, nullptr);
   }
 
+  void compact()
+  { // relayout in chain order, cached nodes go into contiguous stretches of
+    // free or fresh blocks, with a spare slot after every 8 for later
+    // inserts to land in; without cache_nodes<T> the nodes are merely
+    // reallocated in order and contiguity is up to the allocator; values are
+    // only moved if that can not throw, so *this is unchanged on throw
+    if (empty()) [[unlikely]] return;
+
+    list r;
+
+    auto const append([&](node* const q) noexcept
+      {
+        q->l_ = detail::conv(r.l_);
+        r.l_ ? r.l_->l_ ^= detail::conv(q) : bool(r.f_ = q);
+        r.l_ = q;
+      }
+    );
+
+    if constexpr(cache_nodes<T>)
+    {
+      using cache = detail::node_cache<sizeof(node), alignof(node)>;
+
+      auto const p(cache::allocate_run(size()));
+
+      auto i(cbegin());
+      std::size_t j{};
+
+      try
+      {
+        for (; i.n_; ++i, ++j)
+          if constexpr(std::is_trivially_copyable_v<T>)
+          { // relocate
+            std::memcpy(p[j], i.n_, sizeof(node));
+            append(static_cast<node*>(p[j]));
+          }
+          else
+            append(::new (p[j]) node(std::move_if_noexcept(i.n_->v_)));
+      }
+      catch (...)
+      { // return the unused blocks
+        for (; p.size() != j; ++j) cache::deallocate(p[j]);
+        throw;
+      }
+    }
+    else
+      for (auto& v: *this) r.emplace_back(std::move_if_noexcept(v));
+
+    swap(r);
+  }
+
+  //
+  template <class Hash = std::hash<value_type>,
+    class Eq = std::equal_to<value_type>>
+  size_type dedup(Hash hash = Hash(), Eq eq = Eq())
+    requires(requires{hash(*cbegin()); eq(*cbegin(), *cbegin());})
+  { // remove all but the first occurrence of every value, o(n)
+    if (empty()) [[unlikely]] return {};
+
+    // open addressing, linear probing, load factor <= 1/2
+    std::vector<value_type const*> t(std::bit_ceil(2 * size()));
+
+    return remove_if(
+        [&, m(t.size() - 1)](auto const& v)
+          noexcept(noexcept(hash(v), eq(v, v)))
+        {
+          for (std::size_t h(hash(v) & m);; h = (h + 1) & m)
+            if (auto& s(t[h]); !s) return s = std::addressof(v), false;
+            else if (eq(*s, v)) return true;
+        }
+      );
+  }
+
   //
   template <int = 0>
   iterator emplace(const_iterator const i, auto&& ...a)
     noexcept(noexcept(new node{std::forward<decltype(a)>(a)...}))
     requires(std::is_constructible_v<value_type, decltype(a)...>)
-  { // i.p_, q, i.n_
-    auto const q(new node{std::forward<decltype(a)>(a)...});
+  { // i.p_, q, i.n_, cached nodes are placed near a neighbor if possible
+    auto const q([&]
+      {
+        if constexpr(cache_nodes<T>)
+          return new (i.n_ ? i.n_ : i.p_) node{std::forward<decltype(a)>(a)...};
+        else
+          return new node{std::forward<decltype(a)>(a)...};
+      }()
+    );
     q->l_ = detail::conv(i.n_, i.p_);
 
     i.n_ ? i.n_->l_ ^= detail::conv(q, i.p_) : bool(l_ = q);
@@ -522,11 +752,54 @@ public:
     delete i.n_; return {nxt, i.p_};
   }
 
-  iterator erase(const_iterator a, const_iterator const b)
-    noexcept(noexcept(erase(a)))
+  iterator erase(const_iterator const a, const_iterator const b)
+    noexcept(noexcept(node::destroy(a, b)))
+  { // unlink [a, b) with a single boundary relink, then free it
+    if (a != b) [[likely]]
+    {
+      a.p_ ? a.p_->l_ ^= detail::conv(a.n_, b.n_) : bool(f_ = b.n_);
+      b.n_ ? b.n_->l_ ^= detail::conv(b.p_, a.p_) : bool(l_ = a.p_);
+
+      node::destroy(a, b);
+    }
+
+    return {b.n_, a.p_};
+  }
+
+  //
+  [[nodiscard]] node_type extract(const_iterator const i) noexcept
+  { // i.p_, i.n_, nxt
+    auto const nxt(i.n_->link(i.p_));
+
+    nxt ? nxt->l_ ^= detail::conv(i.n_, i.p_) : bool(l_ = i.p_);
+    i.p_ ? i.p_->l_ ^= detail::conv(i.n_, nxt) : bool(f_ = nxt);
+
+    return node_type(i.n_);
+  }
+
+  //
+  void extract_if(auto&& pred, list& o)
+    noexcept(noexcept(pred(*cbegin())))
+  { // relink the elements satisfying pred to the back of o, stable; if pred
+    // throws, nothing is moved and *this keeps every element
+    auto const i(stable_partition(
+        [&pred](auto const& a) noexcept(noexcept(pred(a)))
+        {
+          return !pred(a);
+        }
+      )
+    );
+
+    o.splice(o.cend(), *this, i, cend());
+  }
+
+  [[nodiscard]] list extract_if(auto&& pred)
+    noexcept(noexcept(pred(*cbegin())))
   {
-    for (; a != b; a = erase(a));
-    return {a.n_, a.p_};
+    list r;
+    extract_if(std::forward<decltype(pred)>(pred), r);
+
+    return r;
   }
 
   //
@@ -611,6 +884,19 @@ public:
     return insert(i, l.begin(), l.end());
   }
 
+  iterator insert(const_iterator const i, node_type&& nh) noexcept
+  { // i.p_, q, i.n_
+    if (!nh) [[unlikely]] return {i.n_, i.p_};
+
+    auto const q(std::exchange(nh.n_, {}));
+    q->l_ = detail::conv(i.n_, i.p_);
+
+    i.n_ ? i.n_->l_ ^= detail::conv(q, i.p_) : bool(l_ = q);
+    i.p_ ? i.p_->l_ ^= detail::conv(q, i.n_) : bool(f_ = q);
+
+    return {q, i.p_};
+  }
+
   //
   template <int = 0>
   void assign_range(std::ranges::input_range auto&& rg)
@@ -808,6 +1094,134 @@ public:
     return insert_range<0>(pos, rg);
   }
 
+  //
+  template <class Cmp = std::less<value_type>>
+  iterator insert_sorted(value_type v, Cmp&& cmp = Cmp())
+    noexcept(noexcept(emplace(cbegin(), std::move(v)), cmp(v, v)))
+  { // insert v after the elements not greater than it
+    auto i(cend());
+
+    if (!empty() && cmp(v, back()))
+    { // scan from both ends for the first element greater than v
+      i = cbegin();
+
+      for (auto j(cbefore_end()); (i != j) && !cmp(v, *i);)
+        if (++i == j) break;
+        else if (!cmp(v, *--j)) { i = ++j; break; }
+    }
+
+    return emplace(i, std::move(v));
+  }
+
+  template <class Cmp = std::less<value_type>>
+  void insert_sorted_range(std::ranges::input_range auto&& rg,
+    Cmp&& cmp = Cmp())
+    noexcept(noexcept(list(from_range, std::forward<decltype(rg)>(rg)),
+      std::declval<list&>().sort(cmp),
+      std::declval<list&>().merge(std::declval<list&>(),
+        std::forward<Cmp>(cmp))))
+  { // sort the batch, then merge it in with a single pass
+    list o(from_range, std::forward<decltype(rg)>(rg));
+
+    o.sort(cmp);
+    merge(o, std::forward<Cmp>(cmp));
+  }
+
+  template <class Cmp = std::less<value_type>>
+  void insert_sorted_range(std::initializer_list<T> rg, Cmp&& cmp = Cmp())
+    noexcept(noexcept(insert_sorted_range<Cmp>(std::views::all(rg),
+      std::forward<Cmp>(cmp))))
+  {
+    insert_sorted_range<Cmp>(std::views::all(rg), std::forward<Cmp>(cmp));
+  }
+
+  //
+  iterator stable_partition(const_iterator const b, const_iterator const e,
+    auto pred)
+    noexcept(noexcept(pred(*b)))
+  { // relink [b, e) into a passing and a failing chain, then join them; if
+    // pred throws, the chains are joined ahead of the untested elements
+    if (b == e) [[unlikely]] return {e.n_, e.p_};
+
+    node* c[2][3]{}; // {first, tail's parent, tail} of failing, passing
+
+    auto const join([&](const_iterator const u) noexcept -> iterator
+      { // the untested elements start at u
+        auto const [ff, fp, fl](c[0]);
+        auto const [tf, tp, tl](c[1]);
+
+        // link the tails, then the heads
+        if (tl) tl->l_ = detail::conv(tp, ff ? ff : u.n_);
+        if (fl) fl->l_ = detail::conv(fp, u.n_);
+
+        if (tf) tf->l_ ^= detail::conv(b.p_);
+        if (ff) ff->l_ ^= detail::conv(tl ? tl : b.p_);
+
+        // relink the neighbors of [b, u)
+        auto const h(tf ? tf : ff), t(fl ? fl : tl);
+
+        b.p_ ? b.p_->l_ ^= detail::conv(b.n_, h) : bool(f_ = h);
+        u.n_ ? u.n_->l_ ^= detail::conv(u.p_, t) : bool(l_ = t);
+
+        return {ff ? ff : u.n_, tl ? tl : b.p_}; // the partition point
+      }
+    );
+
+    auto i(b);
+
+    auto const relink([&]
+      {
+        while (i != e)
+        {
+          auto& [f, p, l](c[bool(pred(std::as_const(*i)))]);
+          auto const x(i.n_);
+
+          ++i; // before x is relinked
+          l ? l->l_ = detail::conv(p, x) : bool(f = x); // link l to x
+          detail::assign(p, l)(l, x);
+        }
+      }
+    );
+
+    if constexpr(noexcept(pred(*b)))
+      relink();
+    else
+      try
+      {
+        relink();
+      }
+      catch (...)
+      {
+        if (i != b) join(i);
+        throw;
+      }
+
+    return join(e);
+  }
+
+  auto stable_partition(auto&& pred)
+    noexcept(noexcept(stable_partition(cbegin(), cend(),
+      std::forward<decltype(pred)>(pred))))
+  {
+    return stable_partition(cbegin(), cend(),
+      std::forward<decltype(pred)>(pred));
+  }
+
+  auto partition(const_iterator const b, const_iterator const e, auto&& pred)
+    noexcept(noexcept(stable_partition(b, e,
+      std::forward<decltype(pred)>(pred))))
+  { // relinking is stable at no extra cost
+    return stable_partition(b, e, std::forward<decltype(pred)>(pred));
+  }
+
+  auto partition(auto&& pred)
+    noexcept(noexcept(stable_partition(cbegin(), cend(),
+      std::forward<decltype(pred)>(pred))))
+  {
+    return stable_partition(cbegin(), cend(),
+      std::forward<decltype(pred)>(pred));
+  }
+
   //
   void pop_back() noexcept(noexcept(delete f_))
   {
@@ -827,6 +1241,26 @@ public:
     delete f_; f_ = f;
   }
 
+  void pop_back_n(size_type k) noexcept(noexcept(delete f_))
+  { // pops min(k, size()) elements, relinks once
+    auto i(cend());
+
+    for (; k && i.p_; --k) delete (--i).n_;
+
+    i.p_ ? i.p_->l_ ^= detail::conv(i.n_) : bool(f_ = {});
+    l_ = i.p_;
+  }
+
+  void pop_front_n(size_type k) noexcept(noexcept(delete f_))
+  { // pops min(k, size()) elements, relinks once
+    auto i(cbegin());
+
+    for (; k && i.n_; --k) delete (++i).p_;
+
+    i.n_ ? i.n_->l_ ^= detail::conv(i.p_) : bool(l_ = {});
+    f_ = i.n_;
+  }
+
   //
   template <int = 0>
   void push_back(auto&& ...a)
@@ -858,21 +1292,22 @@ public:
   }
 
   size_type remove_if(auto cmp)
-    noexcept(noexcept(erase(cbegin()), cmp(*cbegin())))
+    noexcept(noexcept(erase(cbegin(), cend()), cmp(*cbegin())))
     requires(requires{cmp(*cbegin());})
   {
     size_type r{};
 
-    if (!empty()) [[likely]]
-    {
-      auto i(cbegin());
+    for (auto i(cbegin()); i;)
+      if (cmp(*i))
+      { // erase a run of consecutive victims at once
+        auto j(i);
 
-      for (auto j(cbefore_end()); i != j;)
-        if ((cmp(*i) ? ++r, i = erase(i) : ++i) == j) break;
-        else cmp(*j) ? ++r, j = --erase(j) : --j;
+        do ++r, ++j; while (j && cmp(*j));
 
-      if (cmp(*i)) ++r, erase(i);
-    }
+        if ((i = erase(i, j))) ++i; // *j was tested already
+      }
+      else
+        ++i;
 
     return r;
   }
@@ -898,6 +1333,17 @@ public:
   //
   void reverse() noexcept { detail::assign(f_, l_)(l_, f_); } // swap
 
+  //
+  iterator rotate(const_iterator const a, const_iterator const m,
+    const_iterator const b) noexcept
+  { // o(1), splice [m, b) before a, returns the new position of a
+    if (a == m) return {b.n_, b.p_}; else if (m == b) return {a.n_, a.p_};
+
+    splice(a, *this, m, b);
+
+    return {a.n_, b.p_};
+  }
+
   //
   template <class Cmp = std::less<value_type>>
   void merge(auto&& o, Cmp&& cmp = Cmp())
@@ -924,6 +1370,135 @@ public:
     detail::assign(o.f_, o.l_)(nullptr, nullptr); // reset o
   }
 
+  template <class Cmp = std::less<value_type>>
+  void merge(std::forward_iterator auto const i, decltype(i) j,
+    Cmp&& cmp = Cmp())
+    requires(std::same_as<list, std::iter_value_t<decltype(i)>>)
+  { // k-way merge of *this and [i, j) with a loser tree, o(n log k)
+    std::vector<std::pair<const_iterator, size_type>> t; // cursors + tree
+    t.reserve(1 + std::distance(i, j));
+
+    node* l{}; // tail, if there is only one nonempty list
+
+    auto const take([&](list& o) noexcept
+      {
+        if (!o.empty()) t.emplace_back(o.cbegin(), size_type{}), l = o.l_;
+        detail::assign(o.f_, o.l_)(nullptr, nullptr); // reset o
+      }
+    );
+
+    take(*this);
+    for (auto k(i); k != j; ++k) if (this != std::addressof(*k)) take(*k);
+
+    if (auto const k(t.size()); 1 == k)
+      detail::assign(f_, l_)(t.front().first.n_, l);
+    else if (k)
+    {
+      // a beats b, if it is smaller, or equal and from an earlier list
+      auto const beats([&](size_type const a, size_type const b)
+        noexcept(noexcept(cmp(*i->cbegin(), *i->cbegin())))
+        {
+          auto const& x(t[a].first), &y(t[b].first);
+          return !y || (x && (a < b ? !cmp(*y, *x) : cmp(*x, *y)));
+        }
+      );
+
+      auto const replay([&](size_type w) noexcept(noexcept(beats(w, w)))
+        { // play w from its leaf up to the root
+          auto n((k + w) / 2);
+
+          for (; n && (~size_type{} != t[n].second); n /= 2)
+            if (beats(t[n].second, w)) std::swap(t[n].second, w);
+
+          t[n].second = w; // park w or store the overall winner
+        }
+      );
+
+      for (auto& e: t) e.second = ~size_type{}; // empty tree
+      for (size_type w{}; w != k; ++w) replay(w); // build tree
+
+      node* p{}, *c{}; // tail's parent, tail
+
+      for (size_type w; (w = t.front().second), t[w].first;)
+      {
+        auto const x(t[w].first.n_);
+        ++t[w].first; // advance the cursor before x gets relinked
+
+        c ? c->l_ = detail::conv(p, x) : bool(f_ = x); // link c to x
+        detail::assign(p, c)(c, x);
+
+        replay(w);
+      }
+
+      c->l_ = detail::conv(p); // c is the new tail
+      l_ = c;
+    }
+  }
+
+private:
+  template <bool A, bool B, bool AB>
+  void set_operation(list& o, auto& cmp)
+    noexcept(noexcept(cmp(*cbegin(), *cbegin()), node::destroy({})))
+  { // keep the elements only in *this (A), only in o (B), in both (AB)
+    if (this == std::addressof(o))
+    {
+      if constexpr(!AB) clear();
+      return;
+    }
+
+    auto i(cbegin()), j(o.cbegin());
+    node* f{}, *p{}, *c{}; // head, tail's parent, tail
+
+    auto const keep([&](const_iterator& k) noexcept
+      {
+        auto const x(k.n_);
+        ++k; // advance the cursor before x gets relinked
+
+        c ? c->l_ = detail::conv(p, x) : bool(f = x); // link c to x
+        detail::assign(p, c)(c, x);
+      }
+    );
+
+    auto const drop([](const_iterator& k) noexcept(noexcept(delete k.n_))
+      {
+        delete (++k).p_;
+      }
+    );
+
+    while (i && j)
+      if (cmp(*i, *j)) A ? keep(i) : drop(i);
+      else if (cmp(*j, *i)) B ? keep(j) : drop(j);
+      else AB ? keep(i) : drop(i), drop(j);
+
+    bool const ki(i);
+    auto& k(ki ? i : j); // the remaining cursor
+
+    if (k && (ki ? A : B))
+    { // relink the rest of k in o(1)
+      k.n_->l_ ^= detail::conv(k.p_, c);
+      c ? c->l_ = detail::conv(p, k.n_) : bool(f = k.n_);
+
+      c = ki ? l_ : o.l_;
+    }
+    else
+    {
+      node::destroy(k);
+
+      if (c) c->l_ = detail::conv(p);
+    }
+
+    detail::assign(f_, l_, o.f_, o.l_)(f, c, nullptr, nullptr);
+  }
+
+public:
+  template <class Cmp = std::less<value_type>>
+  void merge_unique(auto&& o, Cmp cmp = Cmp())
+    noexcept(noexcept(set_operation<true, true, true>(o, cmp)))
+    requires(std::same_as<list, std::remove_reference_t<decltype(o)>>)
+  { // union of sorted lists, o is emptied
+    set_operation<true, true, true>(o, cmp);
+  }
+
   //
   template <int = 0>
   void resize(size_type const c, auto const& ...a)
@@ -957,6 +1532,77 @@ public:
     }
   }
 
+  //
+  template <class G>
+  [[nodiscard]] list sample(size_type k, G&& g)
+  { // selection sampling, extracts min(k, size()) nodes, keeps their order
+    list r;
+
+    auto n(size());
+
+    for (auto i(cbegin()); (k = std::min(k, n)); --n)
+      if (std::uniform_int_distribution<size_type>(0, n - 1)(g) < k)
+      { // pick with probability k / n
+        auto const nxt(i.n_->link(i.p_));
+
+        r.insert(r.cend(), extract(i)), --k;
+        i.n_ = nxt;
+      }
+      else
+        ++i;
+
+    return r;
+  }
+
+  //
+  template <class Cmp = std::less<value_type>>
+  void set_difference(auto&& o, Cmp cmp = Cmp())
+    noexcept(noexcept(set_operation<true, false, false>(o, cmp)))
+    requires(std::same_as<list, std::remove_reference_t<decltype(o)>>)
+  { // sorted lists, o is emptied
+    set_operation<true, false, false>(o, cmp);
+  }
+
+  template <class Cmp = std::less<value_type>>
+  void set_intersection(auto&& o, Cmp cmp = Cmp())
+    noexcept(noexcept(set_operation<false, false, true>(o, cmp)))
+    requires(std::same_as<list, std::remove_reference_t<decltype(o)>>)
+  { // sorted lists, o is emptied
+    set_operation<false, false, true>(o, cmp);
+  }
+
+  template <class Cmp = std::less<value_type>>
+  void set_symmetric_difference(auto&& o, Cmp cmp = Cmp())
+    noexcept(noexcept(set_operation<true, true, false>(o, cmp)))
+    requires(std::same_as<list, std::remove_reference_t<decltype(o)>>)
+  { // sorted lists, o is emptied
+    set_operation<true, true, false>(o, cmp);
+  }
+
+  //
+  template <class G>
+  void shuffle(G&& g)
+  { // shuffle node pointers, then relink
+    std::vector<node*> v;
+    v.reserve(size());
+
+    for (auto i(cbegin()); i; ++i) v.push_back(i.n_);
+
+    if (v.size() > 1) [[likely]]
+    {
+      std::shuffle(v.begin(), v.end(), std::forward<G>(g));
+
+      node* p{};
+
+      for (auto i(v.cbegin()), e(std::prev(v.cend())); i != e; p = *i++)
+        (*i)->l_ = detail::conv(p, i[1]);
+
+      v.back()->l_ = detail::conv(p);
+
+      detail::assign(f_, l_)(v.front(), v.back());
+    }
+  }
+
   //
   #include "sortingalgorithms.hpp"
 
@@ -1004,23 +1650,80 @@ public:
     splice(i, std::forward<decltype(o)>(o), o.cbegin(), o.cend());
   }
 
+  //
+  [[nodiscard]] list split(const_iterator const i) noexcept
+  { // detach [i, end) into a new list
+    list r;
+    r.splice(r.cend(), *this, i, cend());
+
+    return r;
+  }
+
+  [[nodiscard]] auto split_n(size_type const k)
+  { // cut into k lists, sizes differ by at most 1, *this is emptied
+    std::vector<list> r(k);
+
+    if (k) [[likely]]
+    {
+      auto const sz(size());
+      auto const q(sz / k);
+
+      for (auto rm(sz % k); auto& o: r | std::views::take(k - 1))
+      {
+        auto i(cbegin());
+
+        for (auto n(q + bool(rm)); n; --n, ++i);
+        if (rm) --rm;
+
+        o.splice(o.cend(), *this, cbegin(), i);
+      }
+
+      r.back().swap(*this); // the remainder
+    }
+
+    return r;
+  }
+
   //
   void swap(list& o) noexcept
   { // swap state
     detail::assign(f_, l_, o.f_, o.l_)(o.f_, o.l_, f_, l_);
   }
 
+  void swap_ranges(const_iterator const a, const_iterator const b,
+    const_iterator const c, const_iterator const d) noexcept
+  { // o(1), [a, b) must precede [c, d)
+    if (b == c)
+      rotate(a, c, d);
+    else if (c == d)
+      splice(d, *this, a, b);
+    else
+    { // [a, b) [b, c) [c, d) -> [c, d) [a, b) [b, c) -> [c, d) [b, c) [a, b)
+      splice(a, *this, c, d);
+
+      if (a != b) [[likely]]
+        splice({d.n_, c.p_}, *this, {a.n_, d.p_}, b);
+    }
+  }
+
   //
   template <class Cmp = std::equal_to<value_type>>
   size_type unique(Cmp cmp = Cmp())
-    noexcept(noexcept(erase(cbegin()), cmp(*cbegin(), *cbegin())))
+    noexcept(noexcept(erase(cbegin(), cend()), cmp(*cbegin(), *cbegin())))
     requires(requires{cmp(*cbegin(), *cbegin());})
   {
     size_type r{};
 
     if (!empty()) [[likely]]
-      for (auto a(cbegin()), b(cafter_begin()); b;
-        cmp(*a, *b) ? ++r, b = erase(b) : (a = b, ++b));
+      for (auto a(cbegin()), b(cafter_begin()); b; a = b, ++b)
+        if (cmp(*a, *b))
+        { // erase a run of duplicates of *a at once
+          auto e(b);
+
+          do ++r, ++e; while (e && cmp(*a, *e));
+
+          if (!(b = erase(b, e))) break;
+        }
 
     return r;
   }
@@ -1067,6 +1770,139 @@ auto find_if(auto& c, auto cmp)
   return c.end();
 }
 
+namespace detail
+{
+
+template <std::size_t N = 4>
+auto interleave(auto const b, decltype(b) e, auto&& cps, auto f)
+  noexcept(noexcept(f(b)))
+{ // walk [b, e), split at checkpoints cps, N segments at a time, each from
+  // both ends; returns the first iterator f accepted in walk order, or e
+  using iterator = std::remove_const_t<decltype(b)>;
+
+  struct { iterator i, j; } s[N]; // cursors in lockstep
+  std::size_t n{};
+
+  auto const flush([&]() noexcept(noexcept(f(b))) -> iterator
+    {
+      while (n)
+        for (std::size_t k{}; k < n;)
+        {
+          auto& [i, j](s[k]);
+
+          if (f(i)) return i;
+
+          if (i != j)
+          {
+            if (f(j)) return j;
+            if (++i != j) { --j; ++k; continue; }
+          }
+
+          s[k] = s[--n]; // segment done
+        }
+
+      return e;
+    }
+  );
+
+  auto x(b);
+
+  auto const add([&](iterator const y) noexcept
+    {
+      if (x != y) s[n++] = {x, std::prev(y)};
+      x = y;
+    }
+  );
+
+  for (auto const& c: cps)
+    if (add(iterator(c)); N == n)
+      if (auto const r(flush()); r != e) return r;
+
+  add(e);
+
+  return flush();
+}
+
+}
+
+auto for_each_interleaved(auto& c, std::ranges::input_range auto&& cps,
+  auto f)
+  noexcept(noexcept(f(*c.begin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // visits in unspecified order, cps must be iterators into c, in order
+  detail::interleave(c.begin(), c.end(), cps,
+      [&f](auto const i) noexcept(noexcept(f(*i))) { f(*i); return false; }
+    );
+
+  return f;
+}
+
+auto for_each_interleaved(auto& c, auto&& f)
+  noexcept(noexcept(f(*c.begin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return for_each_interleaved(c,
+    std::ranges::empty_view<decltype(c.begin())>(),
+    std::forward<decltype(f)>(f));
+}
+
+auto count_if(auto& c, std::ranges::input_range auto&& cps, auto pred)
+  noexcept(noexcept(pred(*c.cbegin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  typename std::remove_cvref_t<decltype(c)>::size_type r{};
+
+  for_each_interleaved(c, std::forward<decltype(cps)>(cps),
+      [&](auto const& a) noexcept(noexcept(pred(a))) { r += bool(pred(a)); }
+    );
+
+  return r;
+}
+
+auto count_if(auto& c, auto&& pred)
+  noexcept(noexcept(pred(*c.cbegin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return count_if(c, std::ranges::empty_view<decltype(c.begin())>(),
+    std::forward<decltype(pred)>(pred));
+}
+
+auto accumulate(auto& c, std::ranges::input_range auto&& cps, auto init,
+  auto op)
+  noexcept(noexcept(init = op(std::move(init), *c.cbegin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // op must be associative and commutative
+  for_each_interleaved(c, std::forward<decltype(cps)>(cps),
+      [&](auto const& a) noexcept(noexcept(init = op(std::move(init), a)))
+      {
+        init = op(std::move(init), a);
+      }
+    );
+
+  return init;
+}
+
+template <class Op = std::plus<>>
+auto accumulate(auto& c, auto init, Op&& op = Op())
+  noexcept(noexcept(init = op(std::move(init), *c.cbegin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return accumulate(c, std::ranges::empty_view<decltype(c.begin())>(),
+    std::move(init), std::forward<Op>(op));
+}
+
+auto find_if(auto& c, std::ranges::input_range auto&& cps, auto pred)
+  noexcept(noexcept(pred(*c.cbegin())))
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // returns some matching element, not necessarily the first one
+  return detail::interleave(c.begin(), c.end(), cps,
+      [&pred](auto const i) noexcept(noexcept(pred(std::as_const(*i))))
+      {
+        return pred(std::as_const(*i));
+      }
+    );
+}
+
 template <int = 0>
 auto find(auto& c, auto const& ...k)
   noexcept(noexcept(((*c.cbegin() == k) || ...)))
@@ -1098,6 +1934,29 @@ noexcept(noexcept(l.template sort<I>(b, e, std::forward<Cmp>(cmp))))
   l.template sort<I>(b, e, std::forward<Cmp>(cmp));
 }
 
+template <std::forward_iterator It,
+  class Cmp = std::less<typename std::iter_value_t<It>::value_type>>
+auto merge_n(It const i, It const j, Cmp&& cmp = Cmp())
+  noexcept(noexcept(std::iter_value_t<It>().merge(i, j,
+    std::forward<Cmp>(cmp))))
+  requires(requires{std::iter_value_t<It>::xl_list_tag;})
+{ // merge sorted lists [i, j) into a new list, the lists are emptied
+  std::iter_value_t<It> r;
+  r.merge(i, j, std::forward<Cmp>(cmp));
+
+  return r;
+}
+
+auto concat(auto&& ...l) noexcept
+  requires(!!sizeof...(l) &&
+    (requires{std::remove_cvref_t<decltype(l)>::xl_list_tag;} && ...))
+{ // join lists in o(k), the lists are emptied
+  std::common_type_t<std::remove_cvref_t<decltype(l)>...> r;
+  (r.splice(r.cend(), l), ...);
+
+  return r;
+}
+
 template <typename T>
 void swap(list<T>& l, decltype(l) r) noexcept
 {
@@ -0,0 +1,103 @@
+#ifndef XL_MPSCQUEUE_HPP
+# define XL_MPSCQUEUE_HPP
+# pragma once
+
+#include <mutex>
+
+#include "list.hpp"
+
+namespace xl
+{
+
+template <typename T>
+class mpsc_queue
+{ // many producers, one consumer, nodes are allocated outside the lock
+public:
+  using value_type = T;
+
+  class producer
+  { // owned by a single producer thread, stages elements privately
+    mpsc_queue& q_;
+    list<T> s_;
+
+  public:
+    explicit producer(mpsc_queue& q) noexcept: q_(q) { }
+
+    producer(producer const&) = delete;
+    producer& operator=(producer const&) = delete;
+
+    ~producer()
+    { // staged elements are dropped if they can not be published
+      try
+      {
+        flush();
+      }
+      catch (...)
+      {
+      }
+    }
+
+    //
+    auto& emplace(auto&& ...a)
+    {
+      return s_.emplace_back(std::forward<decltype(a)>(a)...);
+    }
+
+    void flush() { if (!s_.empty()) q_.push(std::move(s_)); }
+
+    void push(value_type const& v) { s_.push_back(v); }
+    void push(value_type&& v) { s_.push_back(std::move(v)); }
+
+    [[nodiscard]] bool empty() const noexcept { return s_.empty(); }
+  };
+
+private:
+  mutable std::mutex m_;
+  list<T> l_;
+
+public:
+  mpsc_queue() = default;
+
+  mpsc_queue(mpsc_queue const&) = delete;
+  mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+  //
+  [[nodiscard]] list<T> drain()
+  { // hands over everything published so far
+    list<T> r;
+
+    {
+      std::lock_guard const g(m_);
+      r.swap(l_);
+    }
+
+    return r;
+  }
+
+  void emplace(auto&& ...a)
+  {
+    list<T> s;
+    s.emplace_back(std::forward<decltype(a)>(a)...);
+
+    push(std::move(s));
+  }
+
+  void push(list<T>&& s)
+  { // publishes a batch with a single splice
+    std::lock_guard const g(m_);
+    l_.splice(l_.cend(), s);
+  }
+
+  void push(value_type const& v) { emplace(v); }
+  void push(value_type&& v) { emplace(std::move(v)); }
+
+  [[nodiscard]] bool empty() const
+  {
+    std::lock_guard const g(m_);
+    return l_.empty();
+  }
+};
+
+}
+
+#endif // XL_MPSCQUEUE_HPP
@@ -0,0 +1,510 @@
+#ifndef XL_NODECACHE_HPP
+# define XL_NODECACHE_HPP
+# pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::less
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace xl
+{
+
+// specialize as true to allocate list<T> nodes from per-thread magazines
+template <typename T>
+inline constexpr bool cache_nodes{};
+
+namespace detail
+{
+
+template <std::size_t S, std::size_t A>
+class node_cache
+{ // a magazine is a chain of M free blocks, threads allocate from and free
+  // into their own magazines and trade full ones through a lock-free depot,
+  // all blocks are carved from slabs, which are never released, so cached
+  // nodes may be freed at any point, even during static destruction
+  struct block
+  {
+    block* n_; // next block in the magazine
+    block* m_; // next magazine in the depot, first block only
+  };
+
+  static constexpr std::size_t M{64};
+  static constexpr std::size_t K{8}; // blocks per spare
+  static constexpr std::size_t size{S < sizeof(block) ? sizeof(block) : S};
+  static constexpr std::align_val_t align{A < alignof(block) ?
+    alignof(block) : A};
+
+  struct magazine
+  {
+    block* f_{};
+    std::size_t c_{};
+  };
+
+  class slabs
+  { // kept reachable, so leak checkers stay quiet
+    std::mutex m_;
+    std::vector<void*> s_;
+
+  public:
+    void* allocate(std::size_t const n)
+    {
+      auto const p(::operator new(n * size, align));
+
+      try
+      {
+        std::lock_guard const l(m_);
+        s_.push_back(p);
+      }
+      catch (...)
+      {
+        ::operator delete(p, align); throw;
+      }
+
+      return p;
+    }
+  };
+
+  class spill
+  { // loose blocks, freed after their thread's cache was destroyed
+    std::mutex m_;
+    block* f_{};
+    std::size_t c_{};
+
+  public:
+    void push(block* const f, block* const l, std::size_t const n) noexcept
+    {
+      std::lock_guard const g(m_);
+      l->n_ = f_; f_ = f; c_ += n;
+    }
+
+    magazine take(std::size_t const n = M) noexcept
+    { // up to n blocks
+      std::lock_guard const g(m_);
+
+      magazine m{f_, std::min(c_, n)};
+
+      if (m.c_)
+      {
+        auto l(f_);
+        for (auto i(m.c_); --i;) l = l->n_;
+
+        f_ = std::exchange(l->n_, nullptr); c_ -= m.c_;
+      }
+
+      return m;
+    }
+  };
+
+  class depot
+  { // push is a CAS, take() empties the whole stack, so there is no ABA
+    std::atomic<block*> s_{};
+
+  public:
+    void push(block* const f, block* const l) noexcept
+    {
+      for (l->m_ = s_.load(std::memory_order_relaxed);
+        !s_.compare_exchange_weak(l->m_, f, std::memory_order_release,
+          std::memory_order_relaxed););
+    }
+
+    block* take() noexcept
+    {
+      return s_.exchange({}, std::memory_order_acquire);
+    }
+  };
+
+  class runs
+  { // contiguous runs with spare slots, a set bit marks an unclaimed spare,
+    // the unclaimed spares of a dropped run become free blocks again
+    struct run
+    {
+      char* b_, *e_;
+      std::uint64_t t_; // age
+      std::unique_ptr<std::atomic<std::uint64_t>[]> s_;
+
+      std::size_t words() const noexcept
+      {
+        return (std::size_t(e_ - b_) / size + 63) / 64;
+      }
+
+      std::size_t spares() const noexcept
+      {
+        std::size_t r{};
+
+        for (std::size_t i{}; i != words(); ++i)
+          r += std::popcount(s_[i].load(std::memory_order_relaxed));
+
+        return r;
+      }
+
+      void drop(auto const f) const noexcept
+      {
+        for (std::size_t i{}; i != words(); ++i)
+          for (auto v(s_[i].exchange({}, std::memory_order_acquire)); v;
+            v &= v - 1)
+            f(reinterpret_cast<block*>(b_ +
+              (64 * i + std::countr_zero(v)) * size));
+      }
+    };
+
+    static constexpr std::size_t cap{std::size_t(1) << 14}; // runs kept
+
+    std::shared_mutex m_;
+    std::vector<run> r_; // by address
+    std::uint64_t t_{};
+    std::atomic<bool> any_{};
+
+    static unsigned nearest(std::uint64_t const v, std::ptrdiff_t const t)
+      noexcept
+    { // the set bit of v closest to bit t
+      if (t <= 0) return std::countr_zero(v);
+      else if (t >= 63) return 63 - std::countl_zero(v);
+
+      auto const h(v >> t), l(v << (64 - t));
+
+      if (!l || (h && (std::countr_zero(h) <= std::countl_zero(l))))
+        return t + std::countr_zero(h);
+      else
+        return t - 1 - std::countl_zero(l);
+    }
+
+  public:
+    void add(char* const b, std::size_t const n, std::size_t const k) noexcept
+    { // every k + 1st slot is spare, the older half of the runs is dropped
+      // once there are too many, the spares are freed if n can not be added
+      try
+      {
+        auto s(std::make_unique<std::atomic<std::uint64_t>[]>((n + 63) / 64));
+
+        for (auto i(k); i < n; i += k + 1)
+          s[i / 64].store(s[i / 64].load(std::memory_order_relaxed) |
+            std::uint64_t(1) << i % 64, std::memory_order_relaxed);
+
+        std::unique_lock const l(m_);
+
+        if (r_.size() >= cap) [[unlikely]]
+          std::erase_if(r_, [t(t_ - cap / 2)](auto& r) noexcept
+            {
+              return r.t_ < t ? r.drop(deallocate), true : false;
+            }
+          );
+
+        r_.insert(std::ranges::upper_bound(r_, b, {}, &run::b_),
+          {b, b + n * size, t_++, std::move(s)});
+        any_.store(true, std::memory_order_release);
+      }
+      catch (...)
+      {
+        for (auto i(k); i < n; i += k + 1) deallocate(b + i * size);
+      }
+    }
+
+    void release(std::vector<block*>& f)
+    { // drops the runs holding any of the sorted free blocks f, their
+      // spares are appended to f, f is unchanged on exception
+      std::unique_lock const l(m_);
+
+      auto const hit([&](run const& r) noexcept
+        {
+          auto const i(std::ranges::lower_bound(f,
+            reinterpret_cast<block*>(r.b_), std::less<>()));
+
+          return (f.end() != i) &&
+            std::less<>()(reinterpret_cast<char*>(*i), r.e_);
+        }
+      );
+
+      std::size_t n{};
+      for (auto& r: r_) if (hit(r)) n += r.spares();
+
+      f.reserve(f.size() + n);
+
+      std::erase_if(r_, [&](auto& r) noexcept
+        {
+          return hit(r) ? r.drop([&](block* const b) noexcept
+            { f.push_back(b); }), true : false;
+        }
+      );
+    }
+
+    void* claim(void const* const h) noexcept
+    { // the unclaimed spare nearest to h, searching h's bitmap word and the
+      // words to either side
+      if (!any_.load(std::memory_order_acquire)) [[likely]] return {};
+
+      std::shared_lock const l(m_);
+
+      auto const c(static_cast<char const*>(h));
+      auto const i(std::ranges::upper_bound(r_, c, std::less<>(), &run::b_));
+
+      if ((r_.begin() == i) || !std::less<>()(c, std::prev(i)->e_)) return {};
+
+      auto& r(*std::prev(i));
+      auto const j(std::size_t(c - r.b_) / size);
+      auto const w(r.words());
+
+      for (;;)
+      { // retry if another thread claimed the spare first
+        auto s(~std::size_t{}), d(s);
+
+        for (auto const k: {j / 64 - 1, j / 64, j / 64 + 1})
+          if (k < w)
+            if (auto const v(r.s_[k].load(std::memory_order_relaxed)); v)
+            {
+              auto const b(64 * k + nearest(v,
+                std::ptrdiff_t(j) - std::ptrdiff_t(64 * k)));
+
+              if (auto const e(b < j ? j - b : b - j); e < d) s = b, d = e;
+            }
+
+        if (!~d) return {};
+
+        if (auto const m(std::uint64_t(1) << s % 64);
+          r.s_[s / 64].fetch_and(~m, std::memory_order_acquire) & m)
+          return r.b_ + s * size;
+      }
+    }
+  };
+
+  static auto& slab()
+  { // never destroyed
+    static auto const s(new slabs);
+    return *s;
+  }
+
+  static auto& reg()
+  {
+    static auto const r(new runs);
+    return *r;
+  }
+
+  static inline depot d_;
+  static inline spill p_;
+  static inline thread_local bool dead_; // the thread's cache is gone
+
+  struct cache
+  {
+    magazine a_, b_; // loaded and previous
+    block* h_{}; // full magazines taken from the depot
+
+    ~cache()
+    { // full magazines go to the depot, partial ones to the spill
+      for (auto const m: {&a_, &b_})
+        if (M == m->c_)
+          d_.push(m->f_, m->f_);
+        else if (m->c_)
+        {
+          auto l(m->f_);
+          for (auto i(m->c_); --i;) l = l->n_;
+
+          p_.push(m->f_, l, m->c_);
+        }
+
+      if (auto l(h_); l)
+      {
+        while (l->m_) l = l->m_;
+        d_.push(h_, l);
+      }
+
+      dead_ = true;
+    }
+  };
+
+  static auto& local() noexcept
+  {
+    static thread_local cache c;
+    return c;
+  }
+
+  static void carve()
+  { // a fresh slab into the free lists, in address order, with a spare
+    // after every K blocks for hinted allocations
+    auto const p(static_cast<char*>(slab().allocate(M)));
+
+    for (auto i(M); i--;) if (K != i % (K + 1)) deallocate(p + i * size);
+
+    reg().add(p, M, K);
+  }
+
+  static std::vector<block*> gather()
+  { // every free block of the thread's cache and the depot
+    std::vector<block*> f;
+    if (dead_) [[unlikely]] return f;
+
+    auto& c(local());
+
+    if (auto const d(d_.take()); d)
+    { // the depot joins the hoard
+      auto l(d);
+      while (l->m_) l = l->m_;
+
+      l->m_ = c.h_; c.h_ = d;
+    }
+
+    auto m(c.a_.c_ + c.b_.c_);
+    for (auto h(c.h_); h; h = h->m_) m += M;
+
+    f.reserve(m);
+
+    for (auto const g: {&c.a_, &c.b_})
+      for (; g->c_; --g->c_) f.push_back(std::exchange(g->f_, g->f_->n_));
+
+    while (c.h_)
+    {
+      auto b(std::exchange(c.h_, c.h_->m_));
+      for (auto j(M); j--;) f.push_back(std::exchange(b, b->n_));
+    }
+
+    return f;
+  }
+
+public:
+  static void* allocate()
+  {
+    if (dead_) [[unlikely]]
+      for (;; carve()) // the thread's cache is gone, carve() fills the spill
+        if (auto const m(p_.take(1)); m.c_) return m.f_;
+
+    auto& c(local());
+
+    if (!c.a_.c_)
+    {
+      if (c.b_.c_)
+        std::swap(c.a_, c.b_);
+      else if (c.h_ || (c.h_ = d_.take()))
+        c.a_ = {std::exchange(c.h_, c.h_->m_), M};
+      else if (auto const m(p_.take()); m.c_)
+        c.a_ = m;
+      else
+        carve();
+    }
+
+    --c.a_.c_;
+
+    return std::exchange(c.a_.f_, c.a_.f_->n_);
+  }
+
+  static void* allocate(void const* const h)
+  { // next to h if a spare slot of h's run is close by
+    if (auto const p(reg().claim(h)); p) return p;
+    return allocate();
+  }
+
+  static std::vector<void*> allocate_run(std::size_t const n,
+    std::size_t const k = K)
+  { // n blocks in address order for a relayout, with a spare reserved after
+    // every k > 0 blocks of a contiguous stretch, free blocks are reused if
+    // they form long enough stretches, a fresh slab is carved for the rest
+    std::vector<void*> r;
+    r.reserve(n);
+
+    auto f(gather());
+    std::ranges::sort(f, std::less<>());
+
+    try
+    {
+      reg().release(f);
+    }
+    catch (...)
+    {
+      for (auto const b: f) deallocate(b);
+      throw;
+    }
+
+    std::ranges::sort(f, std::less<>()); // with the released spares
+
+    auto const take([&](char* const b, std::size_t const m) noexcept
+      { // from the stretch of m blocks at b, returns the number used
+        std::size_t j{};
+
+        for (; (m != j) && (n != r.size()); ++j)
+          if (k != j % (k + 1)) r.push_back(b + j * size);
+
+        if (j > k) reg().add(b, j, k);
+
+        return j;
+      }
+    );
+
+    auto const stretch([&](std::size_t const i) noexcept
+      { // the length of the contiguous stretch at f[i]
+        auto j(i + 1);
+
+        for (; (f.size() != j) && (reinterpret_cast<char*>(f[j]) ==
+          reinterpret_cast<char*>(f[j - 1]) + size); ++j);
+
+        return j - i;
+      }
+    );
+
+    auto const pass([&](std::size_t const l) noexcept
+      { // takes from the stretches of at least l blocks, used ones are nulled
+        for (std::size_t i{}, m; (f.size() != i) && (n != r.size()); i += m)
+          if (!f[i])
+            m = 1;
+          else if ((m = stretch(i)) >= l)
+            for (auto j(take(reinterpret_cast<char*>(f[i]), m)); j--;)
+              f[i + j] = {};
+      }
+    );
+
+    pass(n + n / k); // a single stretch that fits everything
+    pass(M);
+
+    for (auto const b: f) if (b) deallocate(b);
+
+    if (auto const rest(n - r.size()); rest)
+    { // a fresh slab with room for the rest and its spares, plus one block
+      // of slack; the blocks take() leaves unused are freed, not kept spare
+      auto const m(rest + rest / k + 1);
+
+      try
+      {
+        auto const b(static_cast<char*>(slab().allocate(m)));
+        for (auto j(take(b, m)); j != m; ++j) deallocate(b + j * size);
+      }
+      catch (...)
+      {
+        for (auto const b: r) deallocate(b);
+        throw;
+      }
+    }
+
+    return r;
+  }
+
+  static void deallocate(void* const p) noexcept
+  { // blocks are interchangeable, remote frees batch into full magazines
+    if (dead_) [[unlikely]]
+      return p_.push(static_cast<block*>(p), static_cast<block*>(p), 1);
+
+    auto& c(local());
+
+    if (M == c.a_.c_)
+    {
+      if (M == c.b_.c_) d_.push(c.b_.f_, c.b_.f_), c.b_ = {};
+      std::swap(c.a_, c.b_);
+    }
+
+    auto const b(static_cast<block*>(p));
+
+    b->n_ = c.a_.f_;
+    c.a_.f_ = b; ++c.a_.c_;
+  }
+
+};
+
+}
+
+}
+
+#endif // XL_NODECACHE_HPP
@@ -0,0 +1,511 @@
+#ifndef XL_PARALLELALGORITHMS_HPP
+# define XL_PARALLELALGORITHMS_HPP
+# pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric> // std::accumulate
+#include <optional>
+#include <thread>
+
+#include "list.hpp"
+
+namespace xl::par
+{
+
+inline std::size_t default_threads() noexcept
+{
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+class pool
+{ // persistent workers, the calling thread always takes part as well
+  std::mutex m_;
+  std::condition_variable cv_;
+  list<std::function<void()>> q_;
+  bool stop_{};
+
+  std::vector<std::thread> t_;
+
+  void work()
+  {
+    for (std::unique_lock l(m_);;)
+    {
+      cv_.wait(l, [&]() noexcept { return stop_ || !q_.empty(); });
+      if (q_.empty()) break;
+
+      auto const f(std::move(q_.front()));
+      q_.pop_front();
+
+      l.unlock(); f(); l.lock();
+    }
+  }
+
+  void stop() noexcept
+  { // queued jobs are still run
+    {
+      std::lock_guard const l(m_);
+      stop_ = true;
+    }
+
+    cv_.notify_all();
+    for (auto& t: t_) t.join();
+  }
+
+public:
+  explicit pool(std::size_t const n = default_threads() - 1)
+  {
+    try
+    {
+      t_.reserve(n);
+      for (std::size_t i{}; i != n; ++i) t_.emplace_back(&pool::work, this);
+    }
+    catch (...)
+    {
+      stop(); throw;
+    }
+  }
+
+  pool(pool const&) = delete;
+  pool& operator=(pool const&) = delete;
+
+  ~pool() { stop(); }
+
+  //
+  static auto& global()
+  {
+    static pool p;
+    return p;
+  }
+
+  //
+  void post(std::function<void()> const& f, std::size_t const n = 1)
+  { // n copies of f, all or none are queued
+    decltype(q_) q;
+    for (std::size_t i{}; i != n; ++i) q.push_back(f);
+
+    {
+      std::lock_guard const l(m_);
+      q_.splice(q_.cend(), q);
+    }
+
+    1 == n ? cv_.notify_one() : cv_.notify_all();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return t_.size(); }
+};
+
+template <typename I>
+auto checkpoints(I b, I const e, std::size_t k)
+{ // a single walk, returns up to k iterators to evenly spaced segment starts
+  std::vector<I> r;
+
+  if (b == e) [[unlikely]] return r; else if (!k) [[unlikely]] k = 1;
+
+  auto const cap(8 * k); // resolution, segments differ by at most 1/4
+  r.reserve(cap);
+
+  std::size_t step(1);
+
+  for (std::size_t n{}; b != e; ++b, ++n)
+    if (!(n & (step - 1)))
+    {
+      if (cap == r.size())
+      { // halve the resolution
+        for (std::size_t j{}; 2 * j < cap; ++j) r[j] = r[2 * j];
+        r.resize(cap / 2);
+
+        if (n & ((step *= 2) - 1)) continue;
+      }
+
+      r.push_back(b);
+    }
+
+  if (auto const m(r.size()); m > k)
+  { // pick k of them
+    for (std::size_t j{}; j != k; ++j) r[j] = r[j * m / k];
+    r.resize(k);
+  }
+
+  return r;
+}
+
+auto checkpoints(auto& c, std::size_t const k)
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return checkpoints(c.begin(), c.end(), k);
+}
+
+namespace detail
+{
+
+void run_n(std::size_t const s, std::size_t t, pool& p, auto const& f)
+{ // f(j) for every j in [0, s), contiguous groups of j are claimed by pool
+  // workers and by the caller, so nested calls can not deadlock
+  t = std::min(std::max(t, std::size_t(1)), s);
+  if (!t) [[unlikely]] return;
+
+  struct batch
+  {
+    std::atomic<std::size_t> n_{}, d_{}; // claimed and done groups
+    std::mutex m_;
+    std::exception_ptr e_;
+  };
+
+  auto const b(std::make_shared<batch>());
+
+  auto const work([b, s, t, &f]() noexcept
+    { // f is only touched while the caller waits for a claimed group
+      for (std::size_t w;
+        (w = b->n_.fetch_add(1, std::memory_order_relaxed)) < t;)
+      {
+        try
+        {
+          for (auto j(w * s / t), k((w + 1) * s / t); j != k; ++j) f(j);
+        }
+        catch (...)
+        {
+          std::lock_guard const l(b->m_);
+          if (!b->e_) b->e_ = std::current_exception();
+        }
+
+        if (t == b->d_.fetch_add(1, std::memory_order_acq_rel) + 1)
+          b->d_.notify_all();
+      }
+    }
+  );
+
+  if (auto const n(std::min(t - 1, p.size())); n) p.post(work, n);
+
+  work();
+
+  for (std::size_t d; t != (d = b->d_.load(std::memory_order_acquire));)
+    b->d_.wait(d, std::memory_order_acquire);
+
+  if (b->e_) std::rethrow_exception(b->e_);
+}
+
+void run(auto const& cps, auto const e, std::size_t const t, pool& p,
+  auto const& f)
+{ // f(j, b, e) for every segment j
+  auto const s(std::size(cps));
+
+  run_n(s, t, p, [&](std::size_t const j)
+    {
+      f(j, cps[j], j + 1 == s ? e : decltype(e)(cps[j + 1]));
+    }
+  );
+}
+
+auto split(auto& c, std::size_t const t)
+{ // cut c into detached parts, back to front, c is emptied
+  auto const cps(checkpoints(c, t));
+
+  std::vector<std::remove_cvref_t<decltype(c)>> r(cps.size());
+  for (auto j(cps.size()); j--;) r[j] = c.split(cps[j]);
+
+  return r;
+}
+
+void join(auto& c, auto& parts) noexcept
+{
+  for (auto& p: parts) c.splice(c.cend(), p);
+}
+
+}
+
+//////////////////////////////////////////////////////////////////////////////
+void for_each(auto& c, std::ranges::random_access_range auto const& cps,
+  auto f, std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // f must be safe to call concurrently
+  detail::run(cps, c.end(), t, p,
+    [&](std::size_t, auto i, auto const e) { for (; i != e; ++i) f(*i); });
+}
+
+void for_each(auto& c, auto&& f, std::size_t const t = default_threads(),
+  pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  for_each(c, checkpoints(c, t), std::forward<decltype(f)>(f), t, p);
+}
+
+void transform(auto& c, std::ranges::random_access_range auto const& cps,
+  auto op, std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // in place, *i = op(*i)
+  detail::run(cps, c.end(), t, p,
+    [&](std::size_t, auto i, auto const e)
+    {
+      for (; i != e; ++i) *i = op(std::as_const(*i));
+    }
+  );
+}
+
+void transform(auto& c, auto&& op, std::size_t const t = default_threads(),
+  pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  transform(c, checkpoints(c, t), std::forward<decltype(op)>(op), t, p);
+}
+
+auto transform_reduce(auto& c,
+  std::ranges::random_access_range auto const& cps, auto init,
+  auto reduce, auto op, std::size_t const t = default_threads(),
+  pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // per segment partial results are reduced in list order, so the result
+  // only depends on cps, not on scheduling
+  std::vector<std::optional<decltype(init)>> v(std::size(cps));
+
+  detail::run(cps, c.end(), t, p,
+    [&](std::size_t const j, auto i, auto const e)
+    {
+      auto& r(v[j].emplace(op(std::as_const(*i))));
+
+      while (++i != e) r = reduce(std::move(r), op(std::as_const(*i)));
+    }
+  );
+
+  for (auto& r: v) if (r) init = reduce(std::move(init), std::move(*r));
+
+  return init;
+}
+
+auto transform_reduce(auto& c, auto init, auto&& reduce, auto&& op,
+  std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return transform_reduce(c, checkpoints(c, t), std::move(init),
+    std::forward<decltype(reduce)>(reduce), std::forward<decltype(op)>(op),
+    t, p);
+}
+
+auto count_if(auto& c, std::ranges::random_access_range auto const& cps,
+  auto pred, std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return transform_reduce(c, cps,
+    typename std::remove_cvref_t<decltype(c)>::size_type{}, std::plus<>(),
+    [&pred](auto const& a) -> typename std::remove_cvref_t<
+      decltype(c)>::size_type { return bool(pred(a)); }, t, p);
+}
+
+auto count_if(auto& c, auto&& pred, std::size_t const t = default_threads(),
+  pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return count_if(c, checkpoints(c, t), std::forward<decltype(pred)>(pred),
+    t, p);
+}
+
+auto find_if(auto& c, std::ranges::random_access_range auto const& cps,
+  auto pred, std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // returns the first match in list order
+  auto const s(std::size(cps));
+
+  std::vector<decltype(c.end())> r(s, c.end());
+  std::atomic<std::size_t> best(s); // lowest segment with a match
+
+  detail::run(cps, c.end(), t, p,
+    [&](std::size_t const j, auto i, auto const e)
+    {
+      for (; (i != e) && (j < best.load(std::memory_order_relaxed)); ++i)
+        if (pred(std::as_const(*i)))
+        {
+          r[j] = i;
+
+          for (auto b(best.load(std::memory_order_relaxed)); (j < b) &&
+            !best.compare_exchange_weak(b, j, std::memory_order_relaxed););
+
+          break;
+        }
+    }
+  );
+
+  return s == best ? c.end() : r[best];
+}
+
+auto find_if(auto& c, auto&& pred, std::size_t const t = default_threads(),
+  pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{
+  return find_if(c, checkpoints(c, t), std::forward<decltype(pred)>(pred),
+    t, p);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+auto remove_if(auto& c, auto pred, std::size_t const t = default_threads(),
+  pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // pred must be safe to call concurrently
+  auto parts(detail::split(c, t));
+  std::vector<typename std::remove_cvref_t<decltype(c)>::size_type> r(
+    parts.size());
+
+  try
+  {
+    detail::run_n(parts.size(), t, p,
+      [&](std::size_t const j) { r[j] = parts[j].remove_if(pred); });
+  }
+  catch (...)
+  {
+    detail::join(c, parts); throw;
+  }
+
+  detail::join(c, parts);
+
+  return std::accumulate(r.cbegin(), r.cend(), typename decltype(r)::value_type{});
+}
+
+template <class Cmp = std::equal_to<>>
+auto unique(auto& c, Cmp const cmp = Cmp(),
+  std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // like the serial unique, every element is compared with the last
+  // survivor before it, so cmp needs not be an equivalence
+  using C = std::remove_cvref_t<decltype(c)>;
+
+  auto parts(detail::split(c, t));
+  std::vector<typename C::size_type> r(parts.size());
+
+  auto const last([&](auto i, auto const e)
+    { // the last survivor of [i, e), if *i survives
+      for (auto j(i); ++j != e;) if (!cmp(*i, *j)) i = j;
+      return i;
+    }
+  );
+
+  // the last survivor of each part and the one carried into it
+  std::vector<typename C::const_iterator> l(parts.size());
+  std::vector<typename C::value_type const*> h(parts.size());
+
+  try
+  {
+    detail::run_n(parts.size(), t, p,
+      [&](std::size_t const j)
+      {
+        l[j] = last(parts[j].cbegin(), parts[j].cend());
+      }
+    );
+
+    typename C::value_type const* a{};
+
+    for (std::size_t j{}; j != parts.size(); ++j)
+    { // only a part whose front is a duplicate needs a second look
+      auto i(parts[j].cbegin());
+      auto const e(parts[j].cend());
+
+      if ((h[j] = a)) for (; (i != e) && cmp(*a, *i); ++i);
+
+      if (i == parts[j].cbegin())
+        a = &*l[j];
+      else if (i != e)
+        a = &*last(i, e);
+    }
+
+    detail::run_n(parts.size(), t, p,
+      [&](std::size_t const j)
+      {
+        auto& q(parts[j]);
+
+        if (auto const a(h[j]); a)
+        {
+          auto i(q.cbegin());
+          for (; (i != q.cend()) && cmp(*a, *i); ++i, ++r[j]);
+          q.erase(q.cbegin(), i);
+        }
+
+        r[j] += q.unique(cmp);
+      }
+    );
+  }
+  catch (...)
+  {
+    detail::join(c, parts); throw;
+  }
+
+  detail::join(c, parts);
+
+  return std::accumulate(r.cbegin(), r.cend(), typename decltype(r)::value_type{});
+}
+
+auto stable_partition(auto& c, auto pred,
+  std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;})
+{ // returns the partition point
+  auto parts(detail::split(c, t));
+  std::vector<std::remove_cvref_t<decltype(c)>> f(parts.size());
+
+  try
+  {
+    detail::run_n(parts.size(), t, p,
+      [&](std::size_t const j)
+      {
+        f[j] = parts[j].split(parts[j].stable_partition(pred));
+      }
+    );
+  }
+  catch (...)
+  { // keep every element, a part whose pred threw still holds all of its
+    // own, the tested ones partitioned ahead of the rest
+    for (std::size_t j{}; j != parts.size(); ++j)
+      c.splice(c.cend(), parts[j]), c.splice(c.cend(), f[j]);
+
+    throw;
+  }
+
+  detail::join(c, parts); // the passing elements
+
+  auto const e(c.empty());
+  auto const l(e ? c.end() : std::prev(c.end()));
+
+  detail::join(c, f); // the failing elements
+
+  return e ? c.begin() : std::next(l);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+void append_range(auto& c, std::ranges::random_access_range auto&& rg,
+  std::size_t t = default_threads(), pool& p = pool::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;} &&
+    std::ranges::sized_range<decltype(rg)>)
+{ // every chunk is built on its own thread, c is unchanged on exception
+  std::size_t const n(std::ranges::size(rg));
+  t = std::min(std::max(t, std::size_t(1)), n);
+
+  std::vector<std::remove_cvref_t<decltype(c)>> parts(t);
+
+  detail::run_n(t, t, p, [&](std::size_t const j)
+    {
+      auto const b(std::ranges::begin(rg));
+      auto const i(b + j * n / t), e(b + (j + 1) * n / t);
+
+      if constexpr(std::is_lvalue_reference_v<decltype(rg)>)
+        std::copy(i, e, std::back_inserter(parts[j]));
+      else
+        std::move(i, e, std::back_inserter(parts[j]));
+    }
+  );
+
+  detail::join(c, parts);
+}
+
+auto make_list(std::ranges::random_access_range auto&& rg,
+  std::size_t const t = default_threads(), pool& p = pool::global())
+  requires(std::ranges::sized_range<decltype(rg)>)
+{
+  list<std::ranges::range_value_t<decltype(rg)>> r;
+  append_range(r, std::forward<decltype(rg)>(rg), t, p);
+
+  return r;
+}
+
+}
+
+#endif // XL_PARALLELALGORITHMS_HPP
@@ -0,0 +1,234 @@
+#ifndef XL_RECLAIMER_HPP
+# define XL_RECLAIMER_HPP
+# pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "list.hpp"
+
+namespace xl
+{
+
+class reclaimer
+{ // destroys handed over lists on a background thread, batch nodes at a
+  // time, pausing between batches if asked to
+  struct job
+  {
+    virtual ~job() = default;
+    virtual bool reclaim(std::size_t) = 0; // true while nodes remain
+  };
+
+  template <class L>
+  struct list_job final: job
+  {
+    L l_;
+
+    explicit list_job(L&& l) noexcept: l_(std::move(l)) { }
+
+    bool reclaim(std::size_t const n) override
+    {
+      l_.pop_front_n(n);
+      return !l_.empty();
+    }
+  };
+
+  std::size_t const b_;
+  std::chrono::microseconds const p_;
+
+  std::mutex m_;
+  std::condition_variable cv_;
+  list<std::unique_ptr<job>> q_;
+  bool busy_{};
+  std::atomic<bool> stop_{};
+
+  std::thread t_;
+
+  void run()
+  {
+    for (std::unique_lock l(m_);;)
+    {
+      busy_ = false;
+      cv_.notify_all();
+
+      cv_.wait(l, [&]() noexcept { return stop_ || !q_.empty(); });
+      if (q_.empty()) break;
+
+      decltype(q_) q;
+      q.swap(q_); busy_ = true;
+
+      l.unlock();
+
+      for (auto& j: q)
+        while (j->reclaim(b_))
+          if (p_.count() && !stop_) std::this_thread::sleep_for(p_);
+
+      q.clear();
+
+      l.lock();
+    }
+  }
+
+public:
+  explicit reclaimer(std::size_t const b = 4096,
+    std::chrono::microseconds const p = {}):
+    b_(std::max(b, std::size_t(1))),
+    p_(p),
+    t_(&reclaimer::run, this)
+  {
+  }
+
+  reclaimer(reclaimer const&) = delete;
+  reclaimer& operator=(reclaimer const&) = delete;
+
+  ~reclaimer()
+  { // everything still queued is destroyed, without pausing
+    {
+      std::lock_guard const l(m_);
+      stop_ = true;
+    }
+
+    cv_.notify_all();
+    t_.join();
+  }
+
+  //
+  static auto& global()
+  {
+    static reclaimer r;
+    return r;
+  }
+
+  //
+  void post(auto&& c)
+    requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;} &&
+      !std::is_lvalue_reference_v<decltype(c)>)
+  { // c is emptied in O(1)
+    if (c.empty()) return;
+
+    auto j(std::make_unique<list_job<std::remove_cvref_t<decltype(c)>>>(
+      std::move(c)));
+
+    {
+      std::lock_guard const l(m_);
+      q_.emplace_back(std::move(j));
+    }
+
+    cv_.notify_one();
+  }
+
+  void wait()
+  { // until everything posted so far is destroyed
+    std::unique_lock l(m_);
+    cv_.wait(l, [&]() noexcept { return q_.empty() && !busy_; });
+  }
+};
+
+void deferred_destroy(auto&& c, reclaimer& r = reclaimer::global())
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;} &&
+    !std::is_lvalue_reference_v<decltype(c)>)
+{
+  r.post(std::move(c));
+}
+
+void deferred_destroy(auto&& c, auto&& ex)
+  requires(requires{std::remove_cvref_t<decltype(c)>::xl_list_tag;} &&
+    !std::is_lvalue_reference_v<decltype(c)> &&
+    std::is_invocable_v<decltype(ex), std::function<void()>>)
+{ // ex runs the destruction wherever it likes
+  ex(std::function<void()>(
+    [p(std::make_shared<std::remove_cvref_t<decltype(c)>>(std::move(c)))]()
+    noexcept { p->clear(); }));
+}
+
+template <class L>
+struct deferred: L
+{ // a list that hands its nodes to the global reclaimer when destroyed,
+  // cleared, assigned or shrunk; erase(), pop_*(), remove_if(), unique() and
+  // calls through L& still free on the calling thread
+  using typename L::size_type;
+  using typename L::value_type;
+
+  using L::L;
+
+  deferred() = default;
+  deferred(deferred const&) = default;
+  deferred(deferred&&) = default;
+
+  ~deferred() { clear(); }
+
+  //
+  deferred& operator=(deferred const& o) { return *this = deferred(o); }
+
+  deferred& operator=(deferred&& o) noexcept
+  { // the old nodes go to the reclaimer, not node::destroy()
+    if (this != std::addressof(o)) clear(), L::swap(o);
+    return *this;
+  }
+
+  deferred& operator=(std::initializer_list<value_type> l)
+  {
+    assign(l); return *this;
+  }
+
+  deferred& operator=(std::ranges::input_range auto&& rg)
+    requires(!std::is_same_v<std::remove_cvref_t<decltype(rg)>, deferred>)
+  {
+    assign_range(std::forward<decltype(rg)>(rg)); return *this;
+  }
+
+  //
+  void assign(auto&& ...a)
+  {
+    clear(); L::assign(std::forward<decltype(a)>(a)...);
+  }
+
+  void assign(size_type const c, value_type const v) { clear(); L::assign(c, v); }
+  void assign(std::initializer_list<value_type> l) { clear(); L::assign(l); }
+
+  void assign_range(std::ranges::input_range auto&& rg)
+  {
+    clear(); L::assign_range(std::forward<decltype(rg)>(rg));
+  }
+
+  void assign_range(std::initializer_list<value_type> rg)
+  {
+    clear(); L::assign_range(rg);
+  }
+
+  void clear() noexcept { hand_over(static_cast<L&&>(*this)); }
+
+  template <int = 0>
+  void resize(size_type const c, auto const& ...a)
+    requires(sizeof...(a) <= 1)
+  { // the cut off tail goes to the reclaimer
+    if (auto const sz(L::size()); c < sz)
+      hand_over(L::split(std::prev(L::cend(), sz - c)));
+    else
+      L::resize(c, a...);
+  }
+
+  void resize(size_type const c, value_type const a) { resize<0>(c, a); }
+
+private:
+  static void hand_over(L&& l) noexcept
+  { // posting allocates and locks, if that fails, free in place
+    try
+    {
+      deferred_destroy(std::move(l));
+    }
+    catch (...)
+    {
+      l.clear();
+    }
+  }
+};
+
+}
+
+#endif // XL_RECLAIMER_HPP
@@ -264,6 +264,84 @@ private:
     }
   };
 
+  template <std::size_t bsize0 = 16>
+  struct merge_sort5
+  { // non-recursive bottom-up natural merge sort, three-way comparisons
+    static void merge(const_iterator& a, const_iterator& b,
+      const_iterator& c, const_iterator& d, auto& cmp)
+      noexcept(noexcept(node::merge3(a, b, c, d, cmp)))
+    { // merge runs [a, b) and [c, d)
+      if (cmp(*c, b.p_->v_) < 0)
+        node::merge3(a, b, c, d, cmp);
+      else
+        b.p_->l_ ^= detail::conv(c.n_),
+        c.n_->l_ ^= detail::conv(b.p_);
+
+      detail::assign(b, c)(d, a);
+    }
+
+    static auto sort(const_iterator i, decltype(i) const e, auto& cmp)
+      noexcept(noexcept(node::merge3(i, i, i, i, cmp)))
+    {
+      auto const lt([&cmp](auto const& a, auto const& b)
+        noexcept(noexcept(cmp(a, b))) { return cmp(a, b) < 0; });
+
+      unsigned mask{}; // occupancy mask
+      std::pair<const_iterator, const_iterator> runs[sizeof(mask) * CHAR_BIT];
+
+      do
+      {
+        auto j(detail::next(i));
+        size_type n(1);
+        bool dsc{}; // strictly descending run?
+
+        if (e != j) [[likely]]
+        { // scan a natural run, equal keys extend ascending runs only
+          if ((dsc = cmp(*j, i.n_->v_) < 0))
+            for (++n, ++j; (e != j) && (cmp(*j, j.p_->v_) < 0); ++n, ++j);
+          else
+            for (++n, ++j; (e != j) && (cmp(*j, j.p_->v_) >= 0); ++n, ++j);
+
+          if (n < bsize0)
+          { // short run, extend and insertion sort it
+            for (; (n < bsize0) && (e != j); ++n, ++j);
+
+            node::insertion_sort(i, j, lt); // sort run [i, j)
+            dsc = {};
+          }
+        }
+
+        auto const m(node::detach(i, j)); // detach run [i, j)
+
+        if (dsc) // a detached XOR chain is reversed by swapping its ends
+          detail::assign(i, j)(const_iterator(j.p_, {}),
+            const_iterator({}, i.n_));
+
+        // merge run [i, j) with valid stored runs
+        auto r(runs);
+
+        for (auto n((++mask, ~mask & (mask - 1))); n; n >>= 1)
+        { // ~(x + 1) & x - isolate trailing ones
+          auto& [a, b](*r++);
+          merge(a, b, i, j, cmp);
+        }
+
+        detail::assign(r->first, r->second, i)(i, j, m); // *r = {i, j}, i = m
+      }
+      while (e != i);
+
+      auto& [c, d](runs[std::countr_zero(mask)]); // first valid stored run
+
+      while (mask &= mask - 1)
+      { // merge remaining valid stored runs
+        auto& [a, b](runs[std::countr_zero(mask)]);
+        merge(a, b, c, d, cmp);
+      }
+
+      return std::pair(c.n_, d.p_);
+    }
+  };
+
 public:
   template <int I = 0, class Cmp = std::less<value_type>>
   void sort(Cmp&& cmp = Cmp())
@@ -275,7 +353,7 @@ public:
   template <int I = 0, class Cmp = std::less<value_type>>
   void sort(const_iterator const b, const_iterator const e, Cmp&& cmp = Cmp())
   noexcept(noexcept(merge_sort<>::sort(b, e, cmp)))
-  requires(0 == I)
+  requires((0 == I) && !detail::three_way_comparator<Cmp, value_type>)
   { // bottom-up merge sort
     if (empty()) [[unlikely]] return;
 
@@ -294,7 +372,7 @@ public:
   void sort(const_iterator const b, const_iterator const e, Cmp&& cmp = Cmp())
   noexcept(noexcept(merge_sort1<Cmp&&>{std::forward<Cmp>(cmp), e, {}, {}}
     ({}, b)))
-  requires(1 == I)
+  requires((1 == I) && !detail::three_way_comparator<Cmp, value_type>)
   {
     auto s(typename list<T>::template merge_sort1<Cmp&&>{
       std::forward<Cmp>(cmp), e, {}, {}});
@@ -315,7 +393,7 @@ public:
   void sort(const_iterator b, const_iterator e, Cmp&& cmp = Cmp())
   noexcept(noexcept(merge_sort2<>::sort(std::declval<const_iterator&>(),
     std::declval<const_iterator&>(), {}, cmp)))
-  requires(2 == I)
+  requires((2 == I) && !detail::three_way_comparator<Cmp, value_type>)
   { // classic merge sort
     auto m(b);
 
@@ -342,7 +420,7 @@ public:
   void sort(const_iterator b, const_iterator e, Cmp&& cmp = Cmp())
   noexcept(noexcept(merge_sort3<>::sort(std::declval<const_iterator&>(),
     std::declval<const_iterator&>(), cmp)))
-  requires(3 == I)
+  requires((3 == I) && !detail::three_way_comparator<Cmp, value_type>)
   {
     merge_sort3<>::sort(b, e, cmp);
 
@@ -354,7 +432,7 @@ public:
   void sort(const_iterator b, const_iterator e, Cmp&& cmp = Cmp())
   noexcept(noexcept(merge_sort4<>::sort(std::declval<const_iterator&>(),
     std::declval<const_iterator&>(), cmp)))
-  requires(4 == I)
+  requires((4 == I) && !detail::three_way_comparator<Cmp, value_type>)
   {
     if (empty()) [[unlikely]] return;
 
@@ -363,3 +441,39 @@ public:
     if (!b.p_) f_ = b.n_;
     if (!e) l_ = e.p_;
   }
+
+  template <int I = 0, class Cmp>
+  void sort(const_iterator const b, const_iterator const e, Cmp&& cmp)
+  noexcept(noexcept(merge_sort5<>::sort(b, e, cmp)))
+  requires(detail::three_way_comparator<Cmp, value_type>)
+  { // three-way comparator, only engine 0 makes use of it
+    if constexpr(I)
+      sort<I>(b, e, [&cmp](auto const& x, auto const& y)
+        noexcept(noexcept(cmp(x, y))) { return cmp(x, y) < 0; });
+    else
+    {
+      if (empty()) [[unlikely]] return;
+
+      auto const [f, l](merge_sort5<>::sort(b, e, cmp));
+
+      b.p_ ? b.p_->l_ ^= detail::conv(f),
+        f->l_ ^= detail::conv(b.p_) :
+        bool(f_ = f);
+
+      e ? e.n_->l_ ^= detail::conv(l),
+        l->l_ ^= detail::conv(e.n_) :
+        bool(l_ = l);
+    }
+  }
+
+  template <int I = 0, class Cmp = std::less<value_type>>
+  void sort_appended(const_iterator const i, Cmp&& cmp = Cmp())
+  noexcept(noexcept(std::declval<list&>().template sort<I>(cmp),
+    std::declval<list&>().merge(std::declval<list&>(), std::forward<Cmp>(cmp))))
+  { // [begin, i) is sorted, sort [i, end) and merge it with [begin, i)
+    list o;
+    o.splice(o.cend(), *this, i, cend()); // detach the appended tail
+
+    o.template sort<I>(cmp);
+    merge(o, std::forward<Cmp>(cmp));
+  }
@@ -53,6 +53,7 @@ void test_run(std::string_view const& title, auto& l1)
   xl::list l4(xl::from_range, l1);
   xl::list l5(xl::from_range, l1);
   xl::list l6(xl::from_range, l1);
+  xl::list l7(xl::from_range, l1);
 
   decltype(std::chrono::high_resolution_clock::now()) start, end;
 
@@ -87,6 +88,11 @@ void test_run(std::string_view const& title, auto& l1)
   end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> const xl_sort_time4(end - start);
 
+  start = std::chrono::high_resolution_clock::now();
+  l7.sort(std::compare_three_way());
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> const xl_sort_time3w(end - start);
+
   // Print the results
   std::cout << "std::list::sort time: " << std_sort_time.count() << " seconds" << std::endl;
   std::cout << "xl::sort time: " << xl_sort_time.count() << " seconds" << std::endl;
@@ -94,12 +100,14 @@ void test_run(std::string_view const& title, auto& l1)
   std::cout << "xl::sort2 time: " << xl_sort_time2.count() << " seconds" << std::endl;
   std::cout << "xl::sort3 time: " << xl_sort_time3.count() << " seconds" << std::endl;
   std::cout << "xl::sort4 time: " << xl_sort_time4.count() << " seconds" << std::endl;
+  std::cout << "xl::sort<=> time: " << xl_sort_time3w.count() << " seconds" << std::endl;
 
   assert(l1 == l2);
   assert(l1 == l3);
   assert(l1 == l4);
   assert(l1 == l5);
   assert(l1 == l6);
+  assert(l1 == l7);
 }
 
 int main()